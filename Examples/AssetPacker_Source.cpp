@@ -0,0 +1,144 @@
+#define TINYVK_HEADLESS
+#include "./TinyVulkan.hpp"
+#include <chrono>
+#include <filesystem>
+using namespace tinyvk;
+
+///
+/// TinyVkAssetPack command line packer:
+///     AssetPacker pack <output.tvkpack> [--compress] [--bc7|--etc2 [--mips]] <files/directories...>
+///         Packs files (directories recursively). Names are paths relative to the given directory (or the file name).
+///         --bc7/--etc2 transcode QOI images into BC7/ETC2 RGBA (sRGB) pixel assets, --mips also encodes their mip chains.
+///     AssetPacker list <pack.tvkpack>
+///         Lists the entries of a pack.
+///     AssetPacker bench <pack.tvkpack> <directory> [iterations]
+///         Compares loading every asset from the pack (one mapping + hash lookups) against loading the same assets
+///         as loose files from the directory they were packed from (open/read/close per file).
+///
+
+static const char* GetTypeName(TinyVkAssetType type) {
+    switch (type) {
+        case TinyVkAssetType::TINYVK_ASSET_SPIRV: return "spirv";
+        case TinyVkAssetType::TINYVK_ASSET_QOI: return "qoi";
+        case TinyVkAssetType::TINYVK_ASSET_PIXELS: return "pixels";
+        default: return "binary";
+    }
+}
+
+static void PackFile(TinyVkAssetPackWriter& writer, const std::string& name, const std::string& path, bool compress, VkFormat blockFormat, bool mips) {
+    if (blockFormat == VK_FORMAT_UNDEFINED || TinyVkAssetPackWriter::GetAssetType(path) != TinyVkAssetType::TINYVK_ASSET_QOI) {
+        writer.AddFile(name, path, compress);
+        return;
+    }
+
+    TinyVkMappedFile file(path);
+    qoi_desc desc;
+    if (!TinyVkTiledQoi::ReadHeader(file.GetData(), file.GetSize(), desc))
+        throw std::runtime_error("AssetPacker: Invalid QOI image: " + path);
+
+    std::vector<uint8_t> pixels = TinyVkTiledQoi::Decode(file.GetData(), file.GetSize(), desc, 4);
+    std::vector<uint8_t> blocks = TinyVkBlockEncoder::EncodeMipChain(blockFormat, pixels.data(), desc.width, desc.height, (mips) ? 0 : 1);
+    writer.AddPixels(name, blocks.data(), blocks.size(), desc.width, desc.height, blockFormat, compress);
+}
+
+static int PackAssets(int argc, char* argv[]) {
+    TinyVkAssetPackWriter writer;
+    VkFormat blockFormat = VK_FORMAT_UNDEFINED;
+    bool compress = false, mips = false;
+
+    for (int i = 3; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--compress" || arg == "--bc7" || arg == "--etc2" || arg == "--mips") {
+            if (arg == "--compress") compress = true;
+            if (arg == "--bc7") blockFormat = VK_FORMAT_BC7_SRGB_BLOCK;
+            if (arg == "--etc2") blockFormat = VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK;
+            if (arg == "--mips") mips = true;
+            continue;
+        }
+
+        std::filesystem::path input(arg);
+        if (std::filesystem::is_directory(input)) {
+            for (const auto& file : std::filesystem::recursive_directory_iterator(input))
+                if (file.is_regular_file())
+                    PackFile(writer, std::filesystem::relative(file.path(), input).generic_string(), file.path().string(), compress, blockFormat, mips);
+        } else {
+            PackFile(writer, input.filename().generic_string(), input.string(), compress, blockFormat, mips);
+        }
+    }
+
+    writer.Write(argv[2]);
+    std::cout << "Packed " << writer.GetAssetCount() << " assets into " << argv[2] << std::endl;
+    return 0;
+}
+
+static int ListAssets(const std::string& path) {
+    TinyVkAssetPack pack(path);
+    for (size_t i = 0; i < pack.GetEntryCount(); i++) {
+        const TinyVkAssetEntry& entry = pack.GetEntry(i);
+        std::cout << pack.GetName(entry) << "\t" << GetTypeName(entry.type) << "\t" << entry.size << " bytes";
+        if (entry.type == TinyVkAssetType::TINYVK_ASSET_PIXELS) std::cout << " (" << entry.width << "x" << entry.height << ", format " << entry.format << ")";
+        if (entry.compression == TinyVkAssetCompression::TINYVK_ASSET_LZ) std::cout << " (lz: " << entry.storedSize << " bytes)";
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
+static int BenchAssets(const std::string& path, const std::string& directory, int iterations) {
+    std::vector<std::string> names;
+    {
+        TinyVkAssetPack pack(path);
+        for (size_t i = 0; i < pack.GetEntryCount(); i++)
+            names.push_back(pack.GetName(pack.GetEntry(i)));
+    }
+
+    using clock = std::chrono::steady_clock;
+    double packTime = 0.0, looseTime = 0.0;
+    size_t checksum = 0;
+    std::vector<uint8_t> buffer;
+
+    for (int i = 0; i < iterations; i++) {
+        clock::time_point start = clock::now();
+        TinyVkAssetPack pack(path);
+        for (const std::string& name : names) {
+            const TinyVkAssetEntry& entry = pack.GetEntry(name);
+            buffer.resize(static_cast<size_t>(entry.size));
+            pack.ReadInto(entry, buffer.data(), buffer.size());
+            checksum += buffer.empty() ? 0 : buffer[buffer.size() / 2];
+        }
+        packTime += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        start = clock::now();
+        for (const std::string& name : names) {
+            std::ifstream file(std::filesystem::path(directory) / name, std::ios::binary | std::ios::ate);
+            buffer.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+            checksum += buffer.empty() ? 0 : buffer[buffer.size() / 2];
+        }
+        looseTime += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    }
+
+    std::cout << names.size() << " assets, " << iterations << " iterations (checksum " << checksum << ")" << std::endl;
+    std::cout << "Asset pack:  " << packTime / iterations << " ms per load" << std::endl;
+    std::cout << "Loose files: " << looseTime / iterations << " ms per load" << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string command = (argc > 1) ? argv[1] : "";
+
+    try {
+        if (command == "pack" && argc > 3) return PackAssets(argc, argv);
+        if (command == "list" && argc == 3) return ListAssets(argv[2]);
+        if (command == "bench" && argc >= 4) return BenchAssets(argv[2], argv[3], (argc > 4) ? std::max(1, std::atoi(argv[4])) : 10);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << "    AssetPacker pack <output.tvkpack> [--compress] [--bc7|--etc2 [--mips]] <files/directories...>" << std::endl;
+    std::cerr << "    AssetPacker list <pack.tvkpack>" << std::endl;
+    std::cerr << "    AssetPacker bench <pack.tvkpack> <directory> [iterations]" << std::endl;
+    return 1;
+}
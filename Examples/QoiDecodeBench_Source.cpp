@@ -0,0 +1,294 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#define QOI_IMPLEMENTATION
+#include "./images_qoi.h"
+
+///
+/// QOI decoder check and benchmark (standalone, only needs images_qoi.h):
+///     QoiDecodeBench fuzz [iterations] [seed]
+///         Decodes random, truncated and corrupted QOI streams with the reference decoder (the original qoi_decode) and
+///         the optimized decoder (qoi_decode and qoi_decode_into, RGB/RGBA/BGR output) and compares their output byte
+///         for byte. Exits with 1 on any mismatch.
+///     QoiDecodeBench bench [iterations] [files/directories...]
+///         Reports the decode throughput (MB/s of decoded pixels) of both decoders for the QOI files (default: generated images).
+///
+
+/// The reference qoi_decode (one pixel per iteration, byte stores) the optimized decoder must match bit for bit.
+static unsigned char* ReferenceDecode(const void* data, int size, qoi_desc* desc, int channels) {
+    union { struct { unsigned char r, g, b, a; } rgba; unsigned int v; } index[64], px;
+    int px_len, chunks_len, px_pos;
+    int p = 0, run = 0;
+
+    if (data == NULL || desc == NULL || (channels != 0 && channels != 3 && channels != 4) || size < QOI_HEADER_SIZE + 8)
+        return NULL;
+
+    const unsigned char* bytes = (const unsigned char*)data;
+    auto read32 = [&]() { unsigned int v = (bytes[p] << 24) | (bytes[p + 1] << 16) | (bytes[p + 2] << 8) | bytes[p + 3]; p += 4; return v; };
+
+    unsigned int header_magic = read32();
+    desc->width = read32();
+    desc->height = read32();
+    desc->channels = bytes[p++];
+    desc->colorspace = bytes[p++];
+
+    if (desc->width == 0 || desc->height == 0 || desc->channels < 3 || desc->channels > 4 || desc->colorspace > 1 ||
+        header_magic != QOI_MAGIC || desc->height >= QOI_PIXELS_MAX / desc->width)
+        return NULL;
+
+    if (channels == 0) channels = desc->channels;
+
+    px_len = desc->width * desc->height * channels;
+    unsigned char* pixels = (unsigned char*)malloc(px_len);
+    if (!pixels) return NULL;
+
+    memset(index, 0, sizeof(index));
+    px.rgba.r = 0;
+    px.rgba.g = 0;
+    px.rgba.b = 0;
+    px.rgba.a = 255;
+
+    chunks_len = size - 8;
+    for (px_pos = 0; px_pos < px_len; px_pos += channels) {
+        if (run > 0) {
+            run--;
+        } else if (p < chunks_len) {
+            int b1 = bytes[p++];
+
+            if (b1 == QOI_OP_RGB) {
+                px.rgba.r = bytes[p++];
+                px.rgba.g = bytes[p++];
+                px.rgba.b = bytes[p++];
+            } else if (b1 == QOI_OP_RGBA) {
+                px.rgba.r = bytes[p++];
+                px.rgba.g = bytes[p++];
+                px.rgba.b = bytes[p++];
+                px.rgba.a = bytes[p++];
+            } else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
+                px = index[b1];
+            } else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+                px.rgba.r += ((b1 >> 4) & 0x03) - 2;
+                px.rgba.g += ((b1 >> 2) & 0x03) - 2;
+                px.rgba.b += (b1 & 0x03) - 2;
+            } else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
+                int b2 = bytes[p++];
+                int vg = (b1 & 0x3f) - 32;
+                px.rgba.r += vg - 8 + ((b2 >> 4) & 0x0f);
+                px.rgba.g += vg;
+                px.rgba.b += vg - 8 + (b2 & 0x0f);
+            } else if ((b1 & QOI_MASK_2) == QOI_OP_RUN) {
+                run = (b1 & 0x3f);
+            }
+
+            index[QOI_COLOR_HASH(px) % 64] = px;
+        }
+
+        pixels[px_pos + 0] = px.rgba.r;
+        pixels[px_pos + 1] = px.rgba.g;
+        pixels[px_pos + 2] = px.rgba.b;
+        if (channels == 4) pixels[px_pos + 3] = px.rgba.a;
+    }
+
+    return pixels;
+}
+
+/// Decoded output of one decoder (empty and !valid if it rejected the stream).
+struct DecodeResult {
+    bool valid = false;
+    qoi_desc desc {};
+    std::vector<uint8_t> pixels;
+};
+
+typedef std::function<void*(const void*, int, qoi_desc*, int)> DecodeFunction;
+typedef std::function<int(const void*, int, qoi_desc*, void*, int, int, int)> DecodeIntoFunction;
+
+static DecodeResult Decode(const DecodeFunction& decode, const std::vector<uint8_t>& data, int channels) {
+    DecodeResult result;
+    void* pixels = decode(data.data(), static_cast<int>(data.size()), &result.desc, channels);
+    if (pixels == nullptr) return result;
+
+    int outChannels = (channels == 0) ? result.desc.channels : channels;
+    result.valid = true;
+    result.pixels.assign(static_cast<uint8_t*>(pixels), static_cast<uint8_t*>(pixels) + static_cast<size_t>(result.desc.width) * result.desc.height * outChannels);
+    free(pixels);
+    return result;
+}
+
+static DecodeResult DecodeInto(const DecodeIntoFunction& decodeInto, const std::vector<uint8_t>& data, int channels, int flags) {
+    DecodeResult result;
+    qoi_desc header {};
+    size_t size = 0;
+    if (qoi_read_header(data.data(), static_cast<int>(data.size()), &header))
+        size = static_cast<size_t>(header.width) * header.height * ((channels == 0) ? header.channels : channels);
+
+    std::vector<uint8_t> pixels(std::max<size_t>(size, 1));
+    if (!decodeInto(data.data(), static_cast<int>(data.size()), &result.desc, pixels.data(), static_cast<int>(size), channels, flags)) return result;
+
+    pixels.resize(size);
+    result.valid = true;
+    result.pixels = std::move(pixels);
+    return result;
+}
+
+/// Swaps the red and blue channels of the reference output (expected QOI_DECODE_BGR output).
+static DecodeResult SwizzleBGR(DecodeResult result, int channels) {
+    int stride = (channels == 0) ? result.desc.channels : channels;
+    for (size_t i = 0; i + 2 < result.pixels.size(); i += stride) std::swap(result.pixels[i], result.pixels[i + 2]);
+    return result;
+}
+
+static bool Matches(const DecodeResult& expected, const DecodeResult& actual) {
+    if (expected.valid != actual.valid) return false;
+    if (!expected.valid) return true;
+    return expected.desc.width == actual.desc.width && expected.desc.height == actual.desc.height &&
+        expected.desc.channels == actual.desc.channels && expected.desc.colorspace == actual.desc.colorspace && expected.pixels == actual.pixels;
+}
+
+/// Generates width x height RGB(A) pixels mixing noise, gradients, runs and a small palette (exercises every QOI op).
+static std::vector<uint8_t> GenerateImage(std::mt19937& random, uint32_t width, uint32_t height, int channels) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * channels);
+    uint8_t palette[8][4];
+    for (auto& color : palette) for (uint8_t& c : color) c = static_cast<uint8_t>(random());
+
+    uint8_t px[4] = { 0, 0, 0, 255 };
+    for (size_t i = 0; i < pixels.size(); i += channels) {
+        switch (random() % 6) {
+            case 0: for (int c = 0; c < 4; c++) px[c] = static_cast<uint8_t>(random()); break;
+            case 1: for (int c = 0; c < 3; c++) px[c] = static_cast<uint8_t>(px[c] + (random() % 3) - 1); break;
+            case 2: { int d = static_cast<int>(random() % 32) - 16; for (int c = 0; c < 3; c++) px[c] = static_cast<uint8_t>(px[c] + d + (random() % 9) - 4); } break;
+            case 3: memcpy(px, palette[random() % 8], 4); break;
+            default: break; // Runs.
+        }
+        memcpy(&pixels[i], px, channels);
+    }
+    return pixels;
+}
+
+static std::vector<uint8_t> Encode(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, int channels) {
+    qoi_desc desc { width, height, static_cast<unsigned char>(channels), QOI_SRGB };
+    int size = 0;
+    void* data = qoi_encode(pixels.data(), &desc, &size);
+    if (data == nullptr) throw std::runtime_error("QoiDecodeBench: qoi_encode failed!");
+
+    std::vector<uint8_t> encoded(static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+    free(data);
+    return encoded;
+}
+
+/// Truncates, corrupts chunk bytes, fills the chunks with garbage or corrupts the header fields (except the size) of a stream.
+static std::vector<uint8_t> Mutate(std::mt19937& random, std::vector<uint8_t> data) {
+    switch (random() % 5) {
+        case 0: break;
+        case 1: data.resize(std::max<size_t>(QOI_HEADER_SIZE, random() % (data.size() + 1))); break;
+        case 2: for (uint32_t i = 1 + random() % 8; i > 0; i--) data[QOI_HEADER_SIZE + random() % (data.size() - QOI_HEADER_SIZE)] = static_cast<uint8_t>(random()); break;
+        case 3: for (size_t i = QOI_HEADER_SIZE + random() % (data.size() - QOI_HEADER_SIZE); i < data.size(); i++) data[i] = static_cast<uint8_t>(random()); break;
+        case 4: { const size_t fields[] = { 0, 3, 12, 13 }; data[fields[random() % 4]] = static_cast<uint8_t>(random() % 6); } break;
+    }
+    return data;
+}
+
+static int FuzzDecoders(int iterations, uint32_t seed) {
+    std::mt19937 random(seed);
+    size_t checks = 0, mismatches = 0, rejected = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        uint32_t width = 1 + random() % 97, height = 1 + random() % 61;
+        int imageChannels = 3 + random() % 2;
+        std::vector<uint8_t> data = Mutate(random, Encode(GenerateImage(random, width, height, imageChannels), width, height, imageChannels));
+
+        for (int channels : { 0, 3, 4 }) {
+            DecodeResult expected = Decode(ReferenceDecode, data, channels);
+            DecodeResult expectedBGR = SwizzleBGR(expected, channels);
+            rejected += (expected.valid) ? 0 : 1;
+
+            const std::pair<const char*, bool> results[] = {
+                { "qoi_decode", Matches(expected, Decode(qoi_decode, data, channels)) },
+                { "qoi_decode_into", Matches(expected, DecodeInto(qoi_decode_into, data, channels, 0)) },
+                { "qoi_decode_into BGR", Matches(expectedBGR, DecodeInto(qoi_decode_into, data, channels, QOI_DECODE_BGR)) }
+            };
+
+            for (const auto& result : results) {
+                checks++;
+                if (result.second) continue;
+                if (mismatches++ < 16)
+                    std::cerr << "Mismatch: " << result.first << " (iteration " << i << ", " << width << "x" << height << ", "
+                        << data.size() << " bytes, channels " << channels << ")" << std::endl;
+            }
+        }
+    }
+
+    std::cout << iterations << " streams (seed " << seed << "), " << checks << " comparisons, " << rejected << " rejected decodes, " << mismatches << " mismatches" << std::endl;
+    return (mismatches == 0) ? 0 : 1;
+}
+
+static int BenchDecoders(int iterations, const std::vector<std::string>& inputs) {
+    std::vector<std::vector<uint8_t>> images;
+    for (const std::string& input : inputs) {
+        std::vector<std::filesystem::path> paths;
+        if (std::filesystem::is_directory(input)) {
+            for (const auto& file : std::filesystem::recursive_directory_iterator(input))
+                if (file.is_regular_file() && file.path().extension() == ".qoi") paths.push_back(file.path());
+        } else paths.push_back(input);
+
+        for (const auto& path : paths) {
+            std::ifstream file(path, std::ios::binary);
+            images.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+    }
+
+    if (images.empty()) {
+        std::mt19937 random(1);
+        for (int channels : { 3, 4 })
+            images.push_back(Encode(GenerateImage(random, 1024, 1024, channels), 1024, 1024, channels));
+    }
+
+    size_t decodedBytes = 0;
+    for (const auto& image : images) {
+        DecodeResult result = Decode(ReferenceDecode, image, 4);
+        if (!result.valid) throw std::runtime_error("QoiDecodeBench: Invalid QOI image!");
+        decodedBytes += result.pixels.size();
+    }
+
+    auto measure = [&](const char* name, const DecodeFunction& decode) {
+        qoi_desc desc;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+            for (const auto& image : images) free(decode(image.data(), static_cast<int>(image.size()), &desc, 4));
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << (static_cast<double>(decodedBytes) * iterations / (1024.0 * 1024.0)) / seconds << " MB/s" << std::endl;
+    };
+
+    std::cout << images.size() << " images, " << decodedBytes << " RGBA bytes, " << iterations << " iterations" << std::endl;
+    measure("Reference:  ", ReferenceDecode);
+    measure("qoi_decode: ", qoi_decode);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string command = (argc > 1) ? argv[1] : "";
+
+    try {
+        if (command == "fuzz") return FuzzDecoders((argc > 2) ? std::max(1, std::atoi(argv[2])) : 20000, (argc > 3) ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1U);
+        if (command == "bench") return BenchDecoders((argc > 2) ? std::max(1, std::atoi(argv[2])) : 20, std::vector<std::string>(argv + std::min(argc, 3), argv + argc));
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << "    QoiDecodeBench fuzz [iterations] [seed]" << std::endl;
+    std::cerr << "    QoiDecodeBench bench [iterations] [files/directories...]" << std::endl;
+    return 1;
+}
@@ -53,17 +53,19 @@ int32_t TINYVULKAN_WINDOWMAIN {
         TinyVkCallback<SwapFrame&>([](SwapFrame& resource){})
     );
 
-    int angle = 0;
-    swapRenderer.onRenderEvents.hook(TinyVkCallback<TinyVkCommandPool&>([&angle, &vkdevice, &window, &swapRenderer, &pipeline, &queue, &clearColor, &depthStencil, &offsets](TinyVkCommandPool& commandPool) {
+    /// Frame packets: everything the render thread needs to draw a frame, produced by the game thread.
+    struct FramePacket {
+        glm::mat4 camera;
+    };
+
+    TinyVkRenderThread<FramePacket> renderThread(swapRenderer);
+    renderThread.onRenderPacket.hook(TinyVkCallback<const FramePacket&, TinyVkCommandPool&>([&swapRenderer, &pipeline, &queue, &clearColor, &depthStencil, &offsets](const FramePacket& packet, TinyVkCommandPool& commandPool) {
         auto frame = queue.GetFrameResource();
 
         auto commandBuffer = commandPool.LeaseBuffer();
         swapRenderer.BeginRecordCmdBuffer(commandBuffer.first, clearColor, depthStencil);
         
-        int offsetx, offsety;
-        offsetx = glm::sin(glm::radians(static_cast<glm::float32>(angle))) * 64;
-        offsety = glm::cos(glm::radians(static_cast<glm::float32>(angle))) * 64;
-        glm::mat4 camera = TinyVkMath::Project2D(window.GetWidth(), window.GetHeight(), offsetx, offsety, 1.0, 0.0);
+        glm::mat4 camera = packet.camera;
         frame.projection.StageBufferData(&camera, sizeof(glm::mat4), 0, 0);
         VkDescriptorBufferInfo cameraDescriptorInfo = frame.projection.GetBufferDescriptor();
         VkWriteDescriptorSet cameraDescriptor = pipeline.SelectWriteBufferDescriptor(0, 1, { &cameraDescriptorInfo });
@@ -72,13 +74,30 @@ int32_t TINYVULKAN_WINDOWMAIN {
         swapRenderer.CmdBindGeometry(commandBuffer.first, &frame.vbuffer.buffer, frame.ibuffer.buffer, offsets, offsets[0]);
         swapRenderer.CmdDrawGeometry(commandBuffer.first, true, 1, 0, 6, 0, 0);
         swapRenderer.EndRecordCmdBuffer(commandBuffer.first, clearColor, depthStencil);
-
-        angle += 1.25;
     }));
 
-    std::thread mythread([&window, &swapRenderer]() { while (!window.ShouldClose()) { swapRenderer.RenderExecute(); } });
+    /// Queue window/input events from GLFW, dispatch them (in posted order) and publish the input snapshot once per frame on the render thread.
+    TinyVkWindow::SetEventDispatch(TinyVkEventDispatch::TINYVK_EVENT_DISPATCH_QUEUED);
+    renderThread.onBeginFrame.hook(TinyVkCallback<>([&window]() { TinyVkWindow::DispatchEvents(); window.PublishInputSnapshot(); }));
+
+    /// The game thread owns the simulation state and only hands immutable frame packets to the render thread.
+    std::thread gameThread([&window, &renderThread]() {
+        float angle = 0.0f;
+
+        while (FramePacket* packet = renderThread.BeginPacket()) {
+            int offsetx = glm::sin(glm::radians(angle)) * 64;
+            int offsety = glm::cos(glm::radians(angle)) * 64;
+            packet->camera = TinyVkMath::Project2D(window.GetWidth(), window.GetHeight(), offsetx, offsety, 1.0, 0.0);
+            renderThread.SubmitPacket();
+
+            angle += 1.25f;
+        }
+    });
+
+    renderThread.Start();
     window.WhileMain(true);
-    mythread.join();
+    renderThread.Stop();
+    gameThread.join();
     
     return VK_SUCCESS;
 }
\ No newline at end of file
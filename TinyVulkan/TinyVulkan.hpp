@@ -35,15 +35,25 @@
         
         Auto inserts window instance extensions:
             #define TINYVK_AUTO_PRESENT_EXTENSIONS
+
+        Headless (surface-less) builds without GLFW, windows, input or swapchain rendering--for offscreen
+        TinyVkImageRenderer workloads on render nodes (add VK_PHYSICAL_DEVICE_TYPE_CPU to the device types for software ICDs):
+            #define TINYVK_HEADLESS
+
+        Per call site lock statistics (acquire wait histograms, timeouts, hold times) for timed_guard / TinyVkLockGuard / TinyVkTryGuard,
+        see TinyVkLockInstrumentation (GetStats(), Dump(), DumpAtExit()):
+            #define TINYVK_LOCK_INSTRUMENTATION
     */
 
-    #define GLFW_INCLUDE_VULKAN
-    #if defined (_WIN32)
-        #define GLFW_EXPOSE_NATIVE_WIN32
-        #define VK_USE_PLATFORM_WIN32_KHR
+    #ifndef TINYVK_HEADLESS
+        #define GLFW_INCLUDE_VULKAN
+        #if defined (_WIN32)
+            #define GLFW_EXPOSE_NATIVE_WIN32
+            #define VK_USE_PLATFORM_WIN32_KHR
+        #endif
+        #include <GLFW/glfw3.h>
+        #include <GLFW/glfw3native.h>
     #endif
-    #include <GLFW/glfw3.h>
-    #include <GLFW/glfw3native.h>
     #include <vulkan/vulkan.h>
 
     #ifdef _DEBUG
@@ -78,6 +88,9 @@
     #define VMA_RECORDING_ENABLED TVK_VALIDATION_LAYERS
     #include "./vk_mem_alloc.hpp"
 
+    #define QOI_IMPLEMENTATION
+    #include "./images_qoi.h"
+
     #define GLM_FORCE_RADIANS
     #define GLM_FORCE_LEFT_HANDED
     #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -95,16 +108,30 @@
     #include <algorithm>
 
     #pragma region BACKEND_SYSTEMS
+    #include "./TinyVulkan/TinyVk_LockInstrumentation.hpp"
     #include "./TinyVulkan/TinyVk_TimedGuard.hpp"
+    #include "./TinyVulkan/TinyVk_Synchronization.hpp"
     #include "./TinyVulkan/TinyVk_Invokable.hpp"
+    #include "./TinyVulkan/TinyVk_EventQueue.hpp"
+    #include "./TinyVulkan/TinyVk_JobSystem.hpp"
     #include "./TinyVulkan/TinyVk_Utilities.hpp"
     #include "./TinyVulkan/TinyVk_Disposable.hpp"
+    #include "./TinyVulkan/TinyVk_MappedFile.hpp"
+    #include "./TinyVulkan/TinyVk_TiledQoi.hpp"
+    #include "./TinyVulkan/TinyVk_BlockCompression.hpp"
+    #include "./TinyVulkan/TinyVk_AssetPack.hpp"
     #pragma endregion
     #pragma region WINDOW_INPUT_HANDLING
+    #ifndef TINYVK_HEADLESS
     #include "./TinyVulkan/TinyVk_InputEnums.hpp"
+    #include "./TinyVulkan/TinyVk_InputState.hpp"
+    #include "./TinyVulkan/TinyVk_GamepadPoller.hpp"
     #include "./TinyVulkan/TinyVk_Window.hpp"
+    #endif
     #pragma endregion
     #pragma region VULKAN_INITIALIZATION
+    #include "./TinyVulkan/TinyVk_DeletionQueue.hpp"
+    #include "./TinyVulkan/TinyVk_SamplerCache.hpp"
     #include "./TinyVulkan/TinyVk_VulkanDevice.hpp"
     #include "./TinyVulkan/TinyVk_CommandPool.hpp"
     #include "./TinyVulkan/TinyVk_GraphicsPipeline.hpp"
@@ -113,8 +140,16 @@
     #include "./TinyVulkan/TinyVk_Buffer.hpp"
     #include "./TinyVulkan/TinyVk_Image.hpp"
     #include "./TinyVulkan/TinyVk_ImageRenderer.hpp"
+    #include "./TinyVulkan/TinyVk_ImageRingRenderer.hpp"
+    #include "./TinyVulkan/TinyVk_ImageReadback.hpp"
+    #include "./TinyVulkan/TinyVk_BatchRenderer.hpp"
+    #ifndef TINYVK_HEADLESS
     #include "./TinyVulkan/TinyVk_SwapChainRenderer.hpp"
+    #include "./TinyVulkan/TinyVk_RenderThread.hpp"
+    #endif
     #include "./TinyVulkan/TinyVk_ResourceQueue.hpp"
+    #include "./TinyVulkan/TinyVk_AssetStreamer.hpp"
+    #include "./TinyVulkan/TinyVk_TextureAtlas.hpp"
     #include "./TinyVulkan/TinyVk_VertexMath.hpp"
     #pragma endregion
 
@@ -0,0 +1,439 @@
+#pragma once
+#ifndef TINYVK_TINYVKASSETPACK
+#define TINYVK_TINYVKASSETPACK
+	#include "./TinyVulkan.hpp"
+	#include <bit>
+	#include <cctype>
+	#include <cstring>
+	#include <map>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkAssetPack is a single-file asset archive which is memory-mapped once (TinyVkMappedFile) and
+			looked up by name hash, so loading thousands of assets costs no per-file open/read/close syscalls.
+
+			Asset Pack Layout: (little-endian)
+				TinyVkAssetPackHeader			magic "TVKP", version, entry count, index/name table offsets.
+				TinyVkAssetEntry[entryCount]	Index sorted by FNV-1a 64-bit name hash (binary searched in place).
+				char[nameTableSize]				Entry names (for listing/tools and to verify hash lookups).
+				...								16-byte aligned entry blobs (SPIR-V, QOI/tiled QOI or pre-swizzled raw pixels).
+
+			Entries can be stored compressed with a small LZ77 (LZ4-style) block codec. Uncompressed entries are read
+			directly from the mapping (zero-copy), compressed entries are decompressed into the destination
+			(e.g. mapped staging memory).
+
+			Names are relative paths with '/' separators ('\' is normalized), e.g. "shaders/sample_vert.spv".
+			Create packs with the TinyVkAssetPackWriter (see Examples/AssetPacker_Source.cpp).
+		*/
+
+		static_assert(std::endian::native == std::endian::little, "TinyVulkan: TinyVkAssetPack requires a little-endian host!");
+
+		enum class TinyVkAssetType : uint32_t {
+			TINYVK_ASSET_BINARY = 0,	/// Raw bytes.
+			TINYVK_ASSET_SPIRV = 1,		/// SPIR-V shader module code.
+			TINYVK_ASSET_QOI = 2,		/// Plain or tiled QOI image.
+			TINYVK_ASSET_PIXELS = 3		/// Raw (pre-swizzled) pixels of width x height in the entry VkFormat.
+		};
+
+		enum class TinyVkAssetCompression : uint32_t {
+			TINYVK_ASSET_UNCOMPRESSED = 0,
+			TINYVK_ASSET_LZ = 1
+		};
+
+		struct TinyVkAssetPackHeader {
+			uint32_t magic;
+			uint32_t version;
+			uint32_t entryCount;
+			uint32_t nameTableSize;
+			uint64_t indexOffset;
+			uint64_t nameTableOffset;
+		};
+
+		struct TinyVkAssetEntry {
+			uint64_t hash;
+			uint64_t offset;
+			uint64_t size;			/// Uncompressed size in bytes.
+			uint64_t storedSize;	/// Size in bytes within the pack.
+			TinyVkAssetType type;
+			TinyVkAssetCompression compression;
+			uint32_t width;
+			uint32_t height;
+			uint32_t format;		/// VkFormat of TINYVK_ASSET_PIXELS entries.
+			uint32_t nameOffset;
+			uint32_t nameLength;
+			uint32_t reserved;
+		};
+
+		static_assert(sizeof(TinyVkAssetPackHeader) == 32 && sizeof(TinyVkAssetEntry) == 64, "TinyVulkan: Unexpected TinyVkAssetPack layout!");
+
+		/// <summary>LZ77 block codec (LZ4-style sequences: token, literals, 16-bit offset, match length) for asset pack entries.</summary>
+		class TinyVkAssetLZ {
+		private:
+			static constexpr size_t LZ_MIN_MATCH = 4;
+			static constexpr size_t LZ_MAX_OFFSET = 65535;
+			static constexpr size_t LZ_HASH_BITS = 16;
+
+			static void WriteLength(std::vector<uint8_t>& out, size_t length) {
+				for (; length >= 255; length -= 255) out.push_back(255);
+				out.push_back(static_cast<uint8_t>(length));
+			}
+
+			static bool ReadLength(const uint8_t*& src, const uint8_t* srcEnd, size_t& length) {
+				uint8_t next;
+				do {
+					if (src >= srcEnd) return false;
+					next = *src++;
+					length += next;
+				} while (next == 255);
+				return true;
+			}
+
+			static void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+				size_t matchCode = (matchLength > 0) ? matchLength - LZ_MIN_MATCH : 0;
+				out.push_back(static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15)));
+				if (literalLength >= 15) WriteLength(out, literalLength - 15);
+				out.insert(out.end(), literals, literals + literalLength);
+
+				if (matchLength == 0) return;
+				out.push_back(static_cast<uint8_t>(offset));
+				out.push_back(static_cast<uint8_t>(offset >> 8));
+				if (matchCode >= 15) WriteLength(out, matchCode - 15);
+			}
+
+		public:
+			/// <summary>Compresses size bytes of data.</summary>
+			static std::vector<uint8_t> Compress(const void* data, size_t size) {
+				const uint8_t* src = static_cast<const uint8_t*>(data);
+				std::vector<uint8_t> out;
+				std::vector<uint32_t> table(1ULL << LZ_HASH_BITS, UINT32_MAX);
+				out.reserve(size / 2 + 16);
+
+				size_t anchor = 0, position = 0;
+				while (size >= LZ_MIN_MATCH && position <= size - LZ_MIN_MATCH) {
+					uint32_t sequence;
+					std::memcpy(&sequence, src + position, sizeof(uint32_t));
+					uint32_t hash = (sequence * 2654435761U) >> (32 - LZ_HASH_BITS);
+					size_t candidate = table[hash];
+					table[hash] = static_cast<uint32_t>(position);
+
+					if (candidate == UINT32_MAX || position - candidate > LZ_MAX_OFFSET || std::memcmp(src + candidate, src + position, LZ_MIN_MATCH) != 0) {
+						position++;
+						continue;
+					}
+
+					size_t matchLength = LZ_MIN_MATCH;
+					while (position + matchLength < size && src[candidate + matchLength] == src[position + matchLength]) matchLength++;
+
+					WriteSequence(out, src + anchor, position - anchor, position - candidate, matchLength);
+					position += matchLength;
+					anchor = position;
+				}
+
+				WriteSequence(out, src + anchor, size - anchor, 0, 0);
+				return out;
+			}
+
+			/// <summary>Decompresses srcSize bytes into exactly dstSize bytes of dst. Returns false if the data is corrupt.</summary>
+			static bool Decompress(const void* data, size_t srcSize, void* dst, size_t dstSize) {
+				const uint8_t* src = static_cast<const uint8_t*>(data);
+				const uint8_t* srcEnd = src + srcSize;
+				uint8_t* out = static_cast<uint8_t*>(dst);
+				size_t position = 0;
+
+				while (src < srcEnd) {
+					uint8_t token = *src++;
+					size_t literalLength = token >> 4;
+					if (literalLength == 15 && !ReadLength(src, srcEnd, literalLength)) return false;
+					if (literalLength > static_cast<size_t>(srcEnd - src) || literalLength > dstSize - position) return false;
+
+					if (literalLength > 0) std::memcpy(out + position, src, literalLength);
+					src += literalLength;
+					position += literalLength;
+					if (src == srcEnd) break;
+
+					if (srcEnd - src < 2) return false;
+					size_t offset = src[0] | (static_cast<size_t>(src[1]) << 8);
+					src += 2;
+
+					size_t matchLength = token & 15;
+					if (matchLength == 15 && !ReadLength(src, srcEnd, matchLength)) return false;
+					matchLength += LZ_MIN_MATCH;
+					if (offset == 0 || offset > position || matchLength > dstSize - position) return false;
+
+					// Matches may overlap their own output (offset < length), so copy forward byte by byte.
+					const uint8_t* match = out + position - offset;
+					for (size_t i = 0; i < matchLength; i++) out[position + i] = match[i];
+					position += matchLength;
+				}
+
+				return position == dstSize;
+			}
+		};
+
+		/// <summary>Memory-mapped, hash indexed asset pack reader.</summary>
+		class TinyVkAssetPack : public TinyVkDisposable {
+		private:
+			TinyVkMappedFile* packFile = nullptr;
+			const TinyVkAssetPackHeader* header = nullptr;
+			const TinyVkAssetEntry* entries = nullptr;
+			const char* nameTable = nullptr;
+
+		public:
+			static constexpr uint32_t PACK_MAGIC = (((uint32_t)'P') << 24) | (((uint32_t)'K') << 16) | (((uint32_t)'V') << 8) | ((uint32_t)'T');
+			static constexpr uint32_t PACK_VERSION = 1;
+			static constexpr uint64_t PACK_ALIGNMENT = 16;
+
+			~TinyVkAssetPack() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				if (packFile == nullptr) return;
+				packFile->Dispose(waitIdle);
+				delete packFile;
+				packFile = nullptr;
+			}
+
+			/// <summary>Memory-maps and validates the asset pack at path (throws if the file is not a valid asset pack).</summary>
+			TinyVkAssetPack(const std::string& path) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+				packFile = new TinyVkMappedFile(path);
+
+				const uint8_t* data = packFile->GetData();
+				size_t size = packFile->GetSize();
+				header = reinterpret_cast<const TinyVkAssetPackHeader*>(data);
+
+				bool valid = size >= sizeof(TinyVkAssetPackHeader) && header->magic == PACK_MAGIC && header->version == PACK_VERSION &&
+					header->indexOffset % alignof(TinyVkAssetEntry) == 0 && header->indexOffset <= size &&
+					header->entryCount <= (size - header->indexOffset) / sizeof(TinyVkAssetEntry) &&
+					header->nameTableOffset <= size && header->nameTableSize <= size - header->nameTableOffset;
+
+				if (valid) {
+					entries = reinterpret_cast<const TinyVkAssetEntry*>(data + header->indexOffset);
+					nameTable = reinterpret_cast<const char*>(data + header->nameTableOffset);
+
+					for (uint32_t i = 0; i < header->entryCount && valid; i++)
+						valid = entries[i].offset <= size && entries[i].storedSize <= size - entries[i].offset &&
+							static_cast<uint64_t>(entries[i].nameOffset) + entries[i].nameLength <= header->nameTableSize &&
+							(i == 0 || entries[i - 1].hash < entries[i].hash);
+				}
+
+				if (!valid) {
+					Disposable(false);
+					throw std::runtime_error("TinyVulkan: Invalid TinyVkAssetPack: " + path);
+				}
+			}
+
+			TinyVkAssetPack operator=(const TinyVkAssetPack& assetPack) = delete;
+
+			/// <summary>Returns the FNV-1a 64-bit hash of the asset name ('\' separators are hashed as '/').</summary>
+			static uint64_t HashName(const std::string& name) {
+				uint64_t hash = 14695981039346656037ULL;
+				for (char c : name) {
+					hash ^= static_cast<uint8_t>((c == '\\') ? '/' : c);
+					hash *= 1099511628211ULL;
+				}
+				return hash;
+			}
+
+			/// <summary>Returns the number of entries in the pack.</summary>
+			size_t GetEntryCount() { return header->entryCount; }
+
+			/// <summary>Returns the entry at index (entries are sorted by name hash).</summary>
+			const TinyVkAssetEntry& GetEntry(size_t index) { return entries[index]; }
+
+			/// <summary>Returns the name stored for the entry.</summary>
+			std::string GetName(const TinyVkAssetEntry& entry) { return std::string(nameTable + entry.nameOffset, entry.nameLength); }
+
+			/// <summary>Returns the entry of the asset name or nullptr if the pack does not contain it.</summary>
+			const TinyVkAssetEntry* Find(const std::string& name) {
+				uint64_t hash = HashName(name);
+				const TinyVkAssetEntry* end = entries + header->entryCount;
+				const TinyVkAssetEntry* entry = std::lower_bound(entries, end, hash, [](const TinyVkAssetEntry& entry, uint64_t hash) { return entry.hash < hash; });
+				if (entry == end || entry->hash != hash || entry->nameLength != name.size()) return nullptr;
+
+				// The writer only rejects collisions between packed names, so a name missing from the pack may share a hash.
+				const char* stored = nameTable + entry->nameOffset;
+				return std::equal(name.begin(), name.end(), stored, [](char c, char s) { return ((c == '\\') ? '/' : c) == s; }) ? entry : nullptr;
+			}
+
+			/// <summary>Returns the entry of the asset name (throws if the pack does not contain it).</summary>
+			const TinyVkAssetEntry& GetEntry(const std::string& name) {
+				const TinyVkAssetEntry* entry = Find(name);
+				if (entry == nullptr)
+					throw std::runtime_error("TinyVulkan: TinyVkAssetPack does not contain asset: " + name);
+				return *entry;
+			}
+
+			/// <summary>Returns the bytes of the entry as stored in the mapped pack (compressed if the entry is compressed).</summary>
+			const uint8_t* GetStoredData(const TinyVkAssetEntry& entry) { return packFile->GetData() + entry.offset; }
+
+			/// <summary>Copies or decompresses the entry into dst (dstSize must be at least entry.size).</summary>
+			void ReadInto(const TinyVkAssetEntry& entry, void* dst, size_t dstSize) {
+				if (dstSize < entry.size)
+					throw std::runtime_error("TinyVulkan: TinyVkAssetPack read destination is too small!");
+
+				if (entry.compression == TinyVkAssetCompression::TINYVK_ASSET_UNCOMPRESSED) {
+					if (entry.storedSize != entry.size)
+						throw std::runtime_error("TinyVulkan: Corrupt TinyVkAssetPack entry: " + GetName(entry));
+					if (entry.size > 0) std::memcpy(dst, GetStoredData(entry), static_cast<size_t>(entry.size));
+				} else if (!TinyVkAssetLZ::Decompress(GetStoredData(entry), static_cast<size_t>(entry.storedSize), dst, static_cast<size_t>(entry.size))) {
+					throw std::runtime_error("TinyVulkan: Corrupt TinyVkAssetPack entry: " + GetName(entry));
+				}
+			}
+
+			/// <summary>Returns a pointer to the uncompressed entry bytes: zero-copy for uncompressed entries, otherwise decompressed into scratch.</summary>
+			const uint8_t* MapEntry(const TinyVkAssetEntry& entry, std::vector<uint8_t>& scratch) {
+				if (entry.compression == TinyVkAssetCompression::TINYVK_ASSET_UNCOMPRESSED && entry.storedSize == entry.size)
+					return GetStoredData(entry);
+
+				scratch.resize(static_cast<size_t>(entry.size));
+				ReadInto(entry, scratch.data(), scratch.size());
+				return scratch.data();
+			}
+
+			/// <summary>Returns a copy of the uncompressed bytes of the asset name.</summary>
+			std::vector<uint8_t> Read(const std::string& name) {
+				const TinyVkAssetEntry& entry = GetEntry(name);
+				std::vector<uint8_t> data(static_cast<size_t>(entry.size));
+				ReadInto(entry, data.data(), data.size());
+				return data;
+			}
+		};
+
+		/// <summary>Builds asset packs (in memory) and writes them to disk.</summary>
+		class TinyVkAssetPackWriter {
+		private:
+			struct TinyVkPendingAsset {
+				std::string name;
+				TinyVkAssetEntry entry;
+				std::vector<uint8_t> data;
+			};
+
+			std::map<uint64_t, TinyVkPendingAsset> assets;
+
+		public:
+			/// <summary>Adds size bytes of data as the asset name (optionally LZ compressed if that makes it smaller).</summary>
+			void AddData(const std::string& name, const void* data, size_t size, TinyVkAssetType type, bool compress = false, uint32_t width = 0, uint32_t height = 0, VkFormat format = VK_FORMAT_UNDEFINED) {
+				std::string normalized = name;
+				std::replace(normalized.begin(), normalized.end(), '\\', '/');
+				uint64_t hash = TinyVkAssetPack::HashName(normalized);
+
+				auto existing = assets.find(hash);
+				if (existing != assets.end() && existing->second.name != normalized)
+					throw std::runtime_error("TinyVulkan: TinyVkAssetPack name hash collision: " + normalized + " / " + existing->second.name);
+
+				TinyVkPendingAsset asset { normalized, {}, {} };
+				asset.entry.hash = hash;
+				asset.entry.size = size;
+				asset.entry.type = type;
+				asset.entry.compression = TinyVkAssetCompression::TINYVK_ASSET_UNCOMPRESSED;
+				asset.entry.width = width;
+				asset.entry.height = height;
+				asset.entry.format = static_cast<uint32_t>(format);
+
+				const uint8_t* bytes = static_cast<const uint8_t*>(data);
+				if (compress && size > 0 && size < UINT32_MAX) {
+					asset.data = TinyVkAssetLZ::Compress(data, size);
+					asset.entry.compression = TinyVkAssetCompression::TINYVK_ASSET_LZ;
+				}
+
+				// Only keep compressed data that saves at least 1/8th of the entry.
+				if (asset.entry.compression == TinyVkAssetCompression::TINYVK_ASSET_UNCOMPRESSED || asset.data.size() > size - size / 8) {
+					asset.data.assign(bytes, bytes + size);
+					asset.entry.compression = TinyVkAssetCompression::TINYVK_ASSET_UNCOMPRESSED;
+				}
+
+				asset.entry.storedSize = asset.data.size();
+				assets[hash] = std::move(asset);
+			}
+
+			/// <summary>Adds size bytes of raw (pre-swizzled) pixels or texel blocks of width x height in the VkFormat of the TinyVkImage they will be staged into (optionally followed by pre-baked mip levels).</summary>
+			void AddPixels(const std::string& name, const void* pixels, size_t size, uint32_t width, uint32_t height, VkFormat format, bool compress = true) {
+				if (width == 0 || height == 0 || size == 0)
+					throw std::runtime_error("TinyVulkan: Invalid TinyVkAssetPack pixel data size for asset: " + name);
+
+				AddData(name, pixels, size, TinyVkAssetType::TINYVK_ASSET_PIXELS, compress, width, height, format);
+			}
+
+			/// <summary>Adds the file at path as the asset name (the type is detected from the extension if not given).</summary>
+			void AddFile(const std::string& name, const std::string& path, bool compress = false, std::optional<TinyVkAssetType> type = std::nullopt) {
+				TinyVkMappedFile file(path);
+				TinyVkAssetType assetType = type.value_or(GetAssetType(path));
+
+				uint32_t width = 0, height = 0;
+				qoi_desc desc;
+				if (assetType == TinyVkAssetType::TINYVK_ASSET_QOI && TinyVkTiledQoi::ReadHeader(file.GetData(), file.GetSize(), desc)) {
+					width = desc.width;
+					height = desc.height;
+				}
+
+				AddData(name, file.GetData(), file.GetSize(), assetType, compress, width, height);
+			}
+
+			/// <summary>Returns the asset type of a file path by its extension (.spv, .qoi, .qoit, otherwise binary).</summary>
+			static TinyVkAssetType GetAssetType(const std::string& path) {
+				std::string extension = path.substr(std::min(path.size(), path.find_last_of('.')));
+				std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+				if (extension == ".spv") return TinyVkAssetType::TINYVK_ASSET_SPIRV;
+				if (extension == ".qoi" || extension == ".qoit") return TinyVkAssetType::TINYVK_ASSET_QOI;
+				return TinyVkAssetType::TINYVK_ASSET_BINARY;
+			}
+
+			/// <summary>Returns the number of assets added to the pack.</summary>
+			size_t GetAssetCount() { return assets.size(); }
+
+			/// <summary>Writes the asset pack to path.</summary>
+			void Write(const std::string& path) {
+				std::string nameTable;
+				std::vector<TinyVkAssetEntry> index;
+
+				uint64_t indexOffset = sizeof(TinyVkAssetPackHeader);
+				uint64_t nameTableOffset = indexOffset + assets.size() * sizeof(TinyVkAssetEntry);
+				for (auto& asset : assets) nameTable += asset.second.name;
+
+				uint64_t offset = nameTableOffset + nameTable.size();
+				uint32_t nameOffset = 0;
+				for (auto& asset : assets) {
+					TinyVkAssetEntry entry = asset.second.entry;
+					offset = (offset + TinyVkAssetPack::PACK_ALIGNMENT - 1) & ~(TinyVkAssetPack::PACK_ALIGNMENT - 1);
+					entry.offset = offset;
+					entry.nameOffset = nameOffset;
+					entry.nameLength = static_cast<uint32_t>(asset.second.name.size());
+					index.push_back(entry);
+
+					offset += entry.storedSize;
+					nameOffset += entry.nameLength;
+				}
+
+				TinyVkAssetPackHeader header {};
+				header.magic = TinyVkAssetPack::PACK_MAGIC;
+				header.version = TinyVkAssetPack::PACK_VERSION;
+				header.entryCount = static_cast<uint32_t>(index.size());
+				header.nameTableSize = static_cast<uint32_t>(nameTable.size());
+				header.indexOffset = indexOffset;
+				header.nameTableOffset = nameTableOffset;
+
+				std::ofstream file(path, std::ios::binary | std::ios::trunc);
+				if (!file.is_open())
+					throw std::runtime_error("TinyVulkan: Failed to open TinyVkAssetPack for writing: " + path);
+
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(TinyVkAssetEntry));
+				file.write(nameTable.data(), nameTable.size());
+
+				const char padding[TinyVkAssetPack::PACK_ALIGNMENT] = {};
+				uint64_t position = nameTableOffset + nameTable.size();
+				size_t i = 0;
+				for (auto& asset : assets) {
+					file.write(padding, static_cast<std::streamsize>(index[i].offset - position));
+					file.write(reinterpret_cast<const char*>(asset.second.data.data()), asset.second.data.size());
+					position = index[i++].offset + asset.second.data.size();
+				}
+
+				if (!file)
+					throw std::runtime_error("TinyVulkan: Failed to write TinyVkAssetPack: " + path);
+			}
+		};
+	}
+
+#endif
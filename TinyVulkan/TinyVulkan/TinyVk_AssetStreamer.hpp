@@ -0,0 +1,610 @@
+#pragma once
+#ifndef TINYVK_TINYVKASSETSTREAMER
+#define TINYVK_TINYVKASSETSTREAMER
+	#include "./TinyVulkan.hpp"
+	#include <atomic>
+	#include <condition_variable>
+	#include <deque>
+	#include <future>
+	#include <limits>
+	#include <queue>
+	#include <thread>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkAssetStreamer loads assets in the background instead of synchronously before rendering starts.
+
+			Requests are ordered by a priority queue (highest priority first, FIFO among equal priorities). Decode jobs on the
+			TinyVkJobSystem (at most workerCount at once) pop the highest priority requests, read each asset from the
+			TinyVkAssetPack (or memory-map the loose file if the pack has no such entry) and decode it straight into a
+			mapped staging TinyVkBuffer:
+				QOI images:		plain or tiled QOI decoded into 8-bit RGBA/BGRA or transcoded into BC7/ETC2 RGBA (the requested format).
+				Pixel assets:	raw pixels/blocks (with any pre-baked mip levels) copied/decompressed in their packed format
+								(the requested format is ignored).
+				Data:			any other asset (SPIR-V, meshes, etc.) delivered as bytes through a std::shared_future.
+
+			RequestImage() immediately returns a TinyVkStreamedImage handle, Get() returns a 1x1 white placeholder image
+			until the streamed image is resident on the GPU. ProcessUploads() must be called once per frame from the
+			render thread (outside of onRenderEvents): it records every decoded image (up to a per-frame byte budget) as
+			transition -> copy -> (mip generation) -> transition into a single command buffer and submits it with a fence
+			without waiting. Once the fence signals the handles become ready, the staging buffers are freed and
+			onImageStreamed is invoked.
+
+			RequestImage(), RequestData() and ReleaseImage() may be called from any thread. Released handles are deleted by
+			the render thread in the next ProcessUploads() once they are no longer loading.
+
+			Decode jobs stop once maxStagingBytes of staging memory are waiting for upload (back-pressure) and are queued
+			again as uploads free staging memory, so a large level streams in progressively at the upload budget rather
+			than allocating every staging buffer at once (and without parking job system workers).
+		*/
+
+		/// <summary>Loading state of a TinyVkStreamedImage.</summary>
+		enum class TinyVkStreamState {
+			TINYVK_STREAM_PENDING,	/// Queued, decoding or uploading--Get() returns the placeholder image.
+			TINYVK_STREAM_READY,	/// Resident on the GPU in SHADER_READONLY_OPTIMAL layout.
+			TINYVK_STREAM_FAILED	/// Failed to load--Get() returns the placeholder image, see GetError().
+		};
+
+		/// <summary>Handle of an image streamed by the TinyVkAssetStreamer, valid until released or the streamer is disposed.</summary>
+		class TinyVkStreamedImage {
+		private:
+			friend class TinyVkAssetStreamer;
+
+			std::atomic<TinyVkStreamState> state = TinyVkStreamState::TINYVK_STREAM_PENDING;
+			std::atomic<bool> released = false;
+			TinyVkImage* image = nullptr;
+			TinyVkImage* placeholder;
+			std::string name;
+			std::string error;
+
+			TinyVkStreamedImage(const std::string& name, TinyVkImage* placeholder) : placeholder(placeholder), name(name) {}
+
+		public:
+			TinyVkStreamedImage(const TinyVkStreamedImage&) = delete;
+			TinyVkStreamedImage& operator=(const TinyVkStreamedImage&) = delete;
+
+			/// <summary>Returns the streamed image if it is ready, otherwise the placeholder image.</summary>
+			TinyVkImage& Get() { return (IsReady()) ? *image : *placeholder; }
+
+			/// <summary>Returns true if the streamed image is resident on the GPU.</summary>
+			bool IsReady() { return state.load(std::memory_order_acquire) == TinyVkStreamState::TINYVK_STREAM_READY; }
+
+			/// <summary>Returns the loading state of the streamed image.</summary>
+			TinyVkStreamState GetState() { return state.load(std::memory_order_acquire); }
+
+			/// <summary>Returns the name (pack entry or file path) of the streamed image.</summary>
+			const std::string& GetName() { return name; }
+
+			/// <summary>Returns the reason the image failed to load (empty unless the state is TINYVK_STREAM_FAILED).</summary>
+			const std::string& GetError() { return error; }
+		};
+
+		/// <summary>Background asset loader with job system decode jobs, a priority queue and budgeted non-blocking GPU uploads.</summary>
+		class TinyVkAssetStreamer : public TinyVkDisposable {
+		private:
+			struct TinyVkStreamJob {
+				int32_t priority;
+				uint64_t sequence;
+				std::string name;
+				VkFormat format;
+				bool generateMipmaps;
+				TinyVkStreamedImage* streamedImage;
+				std::shared_ptr<std::promise<std::vector<uint8_t>>> promise;
+			};
+
+			struct TinyVkStreamJobOrder {
+				bool operator()(const TinyVkStreamJob& a, const TinyVkStreamJob& b) const {
+					return (a.priority != b.priority) ? a.priority < b.priority : a.sequence > b.sequence;
+				}
+			};
+
+			struct TinyVkStreamUpload {
+				TinyVkStreamedImage* streamedImage;
+				TinyVkBuffer* stagingBuffer;
+				VkDeviceSize width, height;
+				VkFormat format;
+				bool generateMipmaps;
+				uint32_t levelCount;
+			};
+
+			struct TinyVkStreamBatch {
+				VkFence fence;
+				std::pair<VkCommandBuffer, int32_t> commandBuffer;
+				std::vector<TinyVkStreamUpload> uploads;
+			};
+
+			std::mutex queue_lock;
+			std::condition_variable queueSignal;
+			std::priority_queue<TinyVkStreamJob, std::vector<TinyVkStreamJob>, TinyVkStreamJobOrder> jobs;
+			std::deque<TinyVkStreamUpload> completedUploads;
+			TinyVkJobSystem& jobSystem;
+			size_t maxDecodeJobs;
+			size_t activeDecodeJobs = 0;
+			bool running = true;
+			uint64_t sequence = 0;
+			VkDeviceSize stagingBytes = 0;
+			std::atomic<size_t> pendingCount = 0;
+
+			/// Streamed image handles, guarded by images_lock.
+			TinyVkSpinMutex images_lock;
+			std::vector<TinyVkStreamedImage*> streamedImages;
+			std::atomic<size_t> releasedCount = 0;
+			std::deque<TinyVkStreamBatch> inflightBatches;
+			std::vector<VkFence> freeFences;
+			TinyVkCommandPool* commandPool;
+			TinyVkImage* placeholder;
+			TinyVkAssetPack* assetPack;
+
+			/// <summary>Creates the 1x1 white image returned by streamed images until they are ready.</summary>
+			void CreatePlaceholder() {
+				uint32_t white = 0xFFFFFFFFU;
+				placeholder = new TinyVkImage(vkdevice, graphicsPipeline, *commandPool, 1, 1, false, VK_FORMAT_B8G8R8A8_SRGB);
+				placeholder->StageImageData(&white, sizeof(white));
+			}
+
+			/// <summary>Reads the whole (decompressed) asset from the asset pack or the loose file.</summary>
+			std::vector<uint8_t> ReadAssetData(const std::string& name) {
+				if (assetPack != nullptr && assetPack->Find(name) != nullptr)
+					return assetPack->Read(name);
+
+				TinyVkMappedFile file(name);
+				return std::vector<uint8_t>(file.GetData(), file.GetData() + file.GetSize());
+			}
+
+			/// <summary>Decodes a QOI image into a new staging buffer (runs in a decode job).</summary>
+			TinyVkStreamUpload DecodeQoiImage(const TinyVkStreamJob& job, const uint8_t* data, size_t dataSize) {
+				bool swizzleBGR = false;
+				bool transcode = TinyVkBlockEncoder::IsEncodableFormat(job.format);
+				if (!transcode && !TinyVkImage::GetQoiFormatSwizzle(job.format, swizzleBGR))
+					throw std::runtime_error("TinyVulkan: QOI images can only be streamed into 8-bit RGBA/BGRA or BC7/ETC2 RGBA TinyVkImages!");
+
+				qoi_desc desc;
+				if (!TinyVkTiledQoi::ReadHeader(data, dataSize, desc))
+					throw std::runtime_error("TinyVulkan: Streamed image is not a valid QOI image: " + job.name);
+
+				if (transcode) {
+					// Compressed images cannot be blitted: every requested mip level is encoded here in the decode job.
+					std::vector<uint8_t> pixels(static_cast<size_t>(desc.width) * desc.height * 4);
+					TinyVkTiledQoi::DecodeInto(data, dataSize, desc, pixels.data(), pixels.size(), 4, false, 1);
+					uint32_t levelCount = (job.generateMipmaps) ? TinyVkImage::GetMaxMipLevels(desc.width, desc.height) : 1;
+					std::vector<uint8_t> blocks = TinyVkBlockEncoder::EncodeMipChain(job.format, pixels.data(), desc.width, desc.height, levelCount, 1);
+
+					TinyVkBuffer* stagingBuffer = new TinyVkBuffer(vkdevice, graphicsPipeline, *commandPool, blocks.size(), TinyVkBufferType::VKVMA_BUFFER_TYPE_STAGING);
+					memcpy(stagingBuffer->description.pMappedData, blocks.data(), blocks.size());
+					return { job.streamedImage, stagingBuffer, desc.width, desc.height, job.format, job.generateMipmaps, levelCount };
+				}
+
+				VkDeviceSize imageSize = static_cast<VkDeviceSize>(desc.width) * desc.height * 4;
+				TinyVkBuffer* stagingBuffer = new TinyVkBuffer(vkdevice, graphicsPipeline, *commandPool, imageSize, TinyVkBufferType::VKVMA_BUFFER_TYPE_STAGING);
+
+				try {
+					TinyVkTiledQoi::DecodeInto(data, dataSize, desc, stagingBuffer->description.pMappedData, static_cast<size_t>(imageSize), 4, swizzleBGR, 1);
+				} catch (...) {
+					stagingBuffer->Dispose(false);
+					delete stagingBuffer;
+					throw;
+				}
+
+				return { job.streamedImage, stagingBuffer, desc.width, desc.height, job.format, job.generateMipmaps, 1 };
+			}
+
+			/// <summary>Reads and decodes a streamed image into a new staging buffer (runs in a decode job).</summary>
+			TinyVkStreamUpload DecodeImage(const TinyVkStreamJob& job) {
+				const TinyVkAssetEntry* entry = (assetPack != nullptr) ? assetPack->Find(job.name) : nullptr;
+
+				if (entry == nullptr) {
+					TinyVkMappedFile file(job.name);
+					file.Prefetch();
+					return DecodeQoiImage(job, file.GetData(), file.GetSize());
+				}
+
+				if (entry->type == TinyVkAssetType::TINYVK_ASSET_QOI) {
+					std::vector<uint8_t> scratch;
+					const uint8_t* data = assetPack->MapEntry(*entry, scratch);
+					return DecodeQoiImage(job, data, static_cast<size_t>(entry->size));
+				}
+
+				if (entry->type != TinyVkAssetType::TINYVK_ASSET_PIXELS)
+					throw std::runtime_error("TinyVulkan: Asset is not an image: " + job.name);
+
+				// PIXELS entries may hold pre-baked mip levels (required for mipmapped block-compressed images).
+				VkFormat format = static_cast<VkFormat>(entry->format);
+				uint32_t levelCount = 1, maxLevels = TinyVkImage::GetMaxMipLevels(entry->width, entry->height);
+				VkDeviceSize chainSize = TinyVkImage::GetFormatByteSize(format, entry->width, entry->height);
+				for (; levelCount < maxLevels && chainSize < entry->size; levelCount++)
+					chainSize += TinyVkImage::GetFormatByteSize(format, TinyVkImage::GetMipExtent(entry->width, levelCount), TinyVkImage::GetMipExtent(entry->height, levelCount));
+
+				if (entry->size == 0 || entry->size != chainSize)
+					throw std::runtime_error("TinyVulkan: Asset pixels do not match the asset width/height/format: " + job.name);
+
+				TinyVkBuffer* stagingBuffer = new TinyVkBuffer(vkdevice, graphicsPipeline, *commandPool, entry->size, TinyVkBufferType::VKVMA_BUFFER_TYPE_STAGING);
+
+				try {
+					assetPack->ReadInto(*entry, stagingBuffer->description.pMappedData, static_cast<size_t>(entry->size));
+				} catch (...) {
+					stagingBuffer->Dispose(false);
+					delete stagingBuffer;
+					throw;
+				}
+
+				return { job.streamedImage, stagingBuffer, entry->width, entry->height, format, job.generateMipmaps, levelCount };
+			}
+
+			/// <summary>Queues decode jobs for the waiting requests, up to maxDecodeJobs at once (call with the queue_lock held).</summary>
+			void ScheduleDecodeJobs() {
+				while (running && activeDecodeJobs < std::min(maxDecodeJobs, jobs.size()) && stagingBytes < maxStagingBytes) {
+					activeDecodeJobs++;
+					jobSystem.Run([this]() { this->DecodeJobs(); });
+				}
+			}
+
+			/// <summary>Decode job: pops the highest priority requests and reads/decodes them until none are left or the staging budget is used up.</summary>
+			void DecodeJobs() {
+				while (true) {
+					std::unique_lock<std::mutex> lock(queue_lock);
+					if (!running || jobs.empty() || stagingBytes >= maxStagingBytes) {
+						activeDecodeJobs--;
+						queueSignal.notify_all();
+						return;
+					}
+
+					TinyVkStreamJob job = jobs.top();
+					jobs.pop();
+					lock.unlock();
+
+					if (job.streamedImage == nullptr) {
+						try {
+							job.promise->set_value(ReadAssetData(job.name));
+						} catch (...) {
+							job.promise->set_exception(std::current_exception());
+						}
+
+						pendingCount--;
+						continue;
+					}
+
+					TinyVkStreamUpload upload { job.streamedImage, nullptr, 0, 0, job.format, job.generateMipmaps, 1 };
+					if (!job.streamedImage->released) {
+						try {
+							upload = DecodeImage(job);
+						} catch (const std::exception& error) {
+							job.streamedImage->error = error.what();
+						} catch (...) {
+							job.streamedImage->error = "TinyVulkan: Unknown error while streaming image: " + job.name;
+						}
+					}
+
+					lock.lock();
+					if (upload.stagingBuffer != nullptr)
+						stagingBytes += upload.stagingBuffer->size;
+
+					completedUploads.push_back(upload);
+				}
+			}
+
+			/// <summary>Finishes a streamed image (ready or failed), released images are deleted by DeleteReleasedImages().</summary>
+			void CompleteImage(TinyVkStreamedImage* streamedImage, TinyVkStreamState state) {
+				pendingCount--;
+				streamedImage->state.store(state, std::memory_order_release);
+
+				if (!streamedImage->released)
+					onImageStreamed.invoke(*streamedImage);
+			}
+
+			/// <summary>Deletes released handles that are no longer loading and their images (render thread).</summary>
+			void DeleteReleasedImages() {
+				if (releasedCount.load(std::memory_order_acquire) == 0) return;
+
+				std::vector<TinyVkStreamedImage*> deleted;
+				{
+					TinyVkLockGuard g(images_lock);
+					std::erase_if(streamedImages, [&deleted](TinyVkStreamedImage* streamedImage) {
+						if (!streamedImage->released || streamedImage->GetState() == TinyVkStreamState::TINYVK_STREAM_PENDING) return false;
+						deleted.push_back(streamedImage);
+						return true;
+					});
+				}
+
+				releasedCount -= deleted.size();
+				for (TinyVkStreamedImage* streamedImage : deleted) {
+					if (streamedImage->image != nullptr) {
+						streamedImage->image->Dispose(true);
+						delete streamedImage->image;
+					}
+
+					delete streamedImage;
+				}
+			}
+
+			/// <summary>Frees the staging buffers of uploads whose command buffer has been executed by the GPU and marks their images ready.</summary>
+			size_t RetireBatches() {
+				size_t retired = 0;
+
+				while (!inflightBatches.empty() && vkGetFenceStatus(vkdevice.logicalDevice, inflightBatches.front().fence) == VK_SUCCESS) {
+					TinyVkStreamBatch batch = std::move(inflightBatches.front());
+					inflightBatches.pop_front();
+
+					VkDeviceSize retiredBytes = 0;
+					for (TinyVkStreamUpload& upload : batch.uploads) {
+						retiredBytes += upload.stagingBuffer->size;
+						upload.stagingBuffer->Dispose(false);
+						delete upload.stagingBuffer;
+					}
+
+					vkdevice.deletionQueue.RetireFence(batch.fence);
+					freeFences.push_back(batch.fence);
+					commandPool->ReturnBuffer(batch.commandBuffer);
+					ReleaseStagingBytes(retiredBytes);
+
+					for (TinyVkStreamUpload& upload : batch.uploads)
+						CompleteImage(upload.streamedImage, TinyVkStreamState::TINYVK_STREAM_READY);
+
+					retired += batch.uploads.size();
+				}
+
+				return retired;
+			}
+
+			/// <summary>Returns staging memory to the decoding budget and resumes decoding.</summary>
+			void ReleaseStagingBytes(VkDeviceSize bytes) {
+				if (bytes == 0) return;
+
+				std::lock_guard<std::mutex> lock(queue_lock);
+				stagingBytes -= bytes;
+				ScheduleDecodeJobs();
+			}
+
+			/// <summary>Records and submits the uploads of decoded images, up to maxUploadBytes (at least one image). Returns the number of failed images.</summary>
+			size_t SubmitUploads(VkDeviceSize maxUploadBytes) {
+				if (!commandPool->HasBuffers()) return 0;
+
+				std::vector<TinyVkStreamUpload> uploads;
+				VkDeviceSize uploadBytes = 0, failedBytes = 0;
+				{
+					std::lock_guard<std::mutex> lock(queue_lock);
+					while (!completedUploads.empty()) {
+						TinyVkStreamUpload& upload = completedUploads.front();
+						VkDeviceSize size = (upload.stagingBuffer != nullptr) ? upload.stagingBuffer->size : 0;
+						if (uploadBytes > 0 && uploadBytes + size > maxUploadBytes) break;
+
+						uploadBytes += size;
+						uploads.push_back(upload);
+						completedUploads.pop_front();
+					}
+				}
+
+				TinyVkStreamBatch batch;
+				size_t failed = 0;
+				for (TinyVkStreamUpload& upload : uploads) {
+					if (upload.stagingBuffer != nullptr && !upload.streamedImage->released) {
+						vmaFlushAllocation(vkdevice.GetAllocator(), upload.stagingBuffer->memory, 0, VK_WHOLE_SIZE);
+						batch.uploads.push_back(upload);
+						continue;
+					}
+
+					if (upload.stagingBuffer != nullptr) {
+						failedBytes += upload.stagingBuffer->size;
+						upload.stagingBuffer->Dispose(false);
+						delete upload.stagingBuffer;
+					}
+
+					CompleteImage(upload.streamedImage, TinyVkStreamState::TINYVK_STREAM_FAILED);
+					failed++;
+				}
+
+				ReleaseStagingBytes(failedBytes);
+				if (batch.uploads.empty()) return failed;
+
+				batch.commandBuffer = commandPool->LeaseBuffer(true);
+				VkCommandBufferBeginInfo beginInfo{};
+				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+				vkBeginCommandBuffer(batch.commandBuffer.first, &beginInfo);
+
+				for (TinyVkStreamUpload& upload : batch.uploads) {
+					bool generate = upload.generateMipmaps && !TinyVkImage::IsCompressedFormat(upload.format);
+					uint32_t mipLevels = (generate) ? TinyVkImage::GetMaxMipLevels(upload.width, upload.height) : upload.levelCount;
+					TinyVkImage* image = new TinyVkImage(vkdevice, graphicsPipeline, *commandPool, upload.width, upload.height, false, upload.format, TINYVK_UNDEFINED, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels);
+					image->TransitionLayoutCmd(batch.commandBuffer.first, TINYVK_TRANSFER_DST_OPTIMAL);
+					image->TransferMipLevelsFromBufferCmd(batch.commandBuffer.first, *upload.stagingBuffer, upload.levelCount);
+					image->GenerateMipmapsCmd(batch.commandBuffer.first, upload.levelCount - 1);
+					upload.streamedImage->image = image;
+				}
+
+				if (vkEndCommandBuffer(batch.commandBuffer.first) != VK_SUCCESS)
+					throw std::runtime_error("TinyVulkan: Failed to record asset streaming command buffer!");
+
+				if (freeFences.empty()) {
+					VkFenceCreateInfo fenceInfo{};
+					fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+					VkFence fence;
+					if (vkCreateFence(vkdevice.logicalDevice, &fenceInfo, nullptr, &fence) != VK_SUCCESS)
+						throw std::runtime_error("TinyVulkan: Failed to create synchronization objects for asset streaming!");
+
+					freeFences.push_back(fence);
+				}
+
+				batch.fence = freeFences.back();
+				freeFences.pop_back();
+				vkResetFences(vkdevice.logicalDevice, 1, &batch.fence);
+
+				VkSubmitInfo submitInfo{};
+				submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+				submitInfo.commandBufferCount = 1;
+				submitInfo.pCommandBuffers = &batch.commandBuffer.first;
+
+				if (vkQueueSubmit(graphicsPipeline.GetGraphicsQueue(), 1, &submitInfo, batch.fence) != VK_SUCCESS)
+					throw std::runtime_error("TinyVulkan: Failed to submit asset streaming command buffer!");
+
+				vkdevice.deletionQueue.SignalSubmission(batch.fence);
+				inflightBatches.push_back(std::move(batch));
+				return failed;
+			}
+
+		public:
+			TinyVkVulkanDevice& vkdevice;
+			TinyVkGraphicsPipeline& graphicsPipeline;
+
+			/// <summary>Staging memory (bytes) that may wait for upload before decoding pauses.</summary>
+			VkDeviceSize maxStagingBytes;
+
+			/// Invokable Streaming Events: (executed in ProcessUploads()/Flush() when a streamed image becomes ready or fails)
+			TinyVkInvokable<TinyVkStreamedImage&> onImageStreamed;
+
+			TinyVkAssetStreamer(const TinyVkAssetStreamer&) = delete;
+			TinyVkAssetStreamer& operator=(const TinyVkAssetStreamer&) = delete;
+
+			~TinyVkAssetStreamer() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				{
+					std::unique_lock<std::mutex> lock(queue_lock);
+					running = false;
+					queueSignal.wait(lock, [this]() { return activeDecodeJobs == 0; });
+				}
+
+				while (!jobs.empty()) {
+					if (jobs.top().promise) jobs.top().promise->set_exception(std::make_exception_ptr(std::runtime_error("TinyVulkan: TinyVkAssetStreamer was disposed!")));
+					jobs.pop();
+				}
+
+				std::vector<VkFence> fences;
+				for (TinyVkStreamBatch& batch : inflightBatches)
+					fences.push_back(batch.fence);
+
+				if (fences.size() > 0)
+					vkWaitForFences(vkdevice.logicalDevice, static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, UINT64_MAX);
+
+				for (TinyVkStreamBatch& batch : inflightBatches) {
+					for (TinyVkStreamUpload& upload : batch.uploads) {
+						upload.stagingBuffer->Dispose(false);
+						delete upload.stagingBuffer;
+					}
+
+					freeFences.push_back(batch.fence);
+				}
+
+				for (TinyVkStreamUpload& upload : completedUploads)
+					if (upload.stagingBuffer != nullptr) {
+						upload.stagingBuffer->Dispose(false);
+						delete upload.stagingBuffer;
+					}
+
+				for (VkFence fence : freeFences) {
+					vkdevice.deletionQueue.RetireFence(fence);
+					vkDestroyFence(vkdevice.logicalDevice, fence, nullptr);
+				}
+
+				for (TinyVkStreamedImage* streamedImage : streamedImages) {
+					if (streamedImage->image != nullptr) {
+						streamedImage->image->Dispose(waitIdle);
+						delete streamedImage->image;
+					}
+
+					delete streamedImage;
+				}
+
+				inflightBatches.clear();
+				completedUploads.clear();
+				freeFences.clear();
+				streamedImages.clear();
+
+				placeholder->Dispose(waitIdle);
+				delete placeholder;
+				commandPool->Dispose(waitIdle);
+				delete commandPool;
+			}
+
+			/// <summary>Creates an asset streamer with up to workerCount concurrent decode jobs (0: one per job system worker) reading from the asset pack (optional) or loose files.</summary>
+			TinyVkAssetStreamer(TinyVkVulkanDevice& vkdevice, TinyVkGraphicsPipeline& graphicsPipeline, TinyVkAssetPack* assetPack = nullptr, size_t workerCount = 0, size_t maxInflightBatches = 8ULL, VkDeviceSize maxStagingBytes = 64ULL << 20, TinyVkJobSystem& jobSystem = TinyVkJobSystem::Default())
+			: vkdevice(vkdevice), graphicsPipeline(graphicsPipeline), jobSystem(jobSystem), assetPack(assetPack), maxStagingBytes(maxStagingBytes) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				if (maxInflightBatches == 0)
+					throw std::runtime_error("TinyVulkan: TinyVkAssetStreamer requires at least 1 in flight upload batch!");
+
+				maxDecodeJobs = (workerCount > 0) ? workerCount : jobSystem.GetWorkerCount();
+				commandPool = new TinyVkCommandPool(vkdevice, maxInflightBatches);
+				CreatePlaceholder();
+
+				SetOwner(vkdevice);
+			}
+
+			/// <summary>Queues an image (QOI or pixel asset) for streaming and returns its handle, higher priorities are loaded first (optionally generates a full mip chain on the GPU).</summary>
+			TinyVkStreamedImage* RequestImage(const std::string& name, int32_t priority = 0, VkFormat format = VK_FORMAT_B8G8R8A8_SRGB, bool generateMipmaps = false) {
+				TinyVkStreamedImage* streamedImage = new TinyVkStreamedImage(name, placeholder);
+				{
+					TinyVkLockGuard g(images_lock);
+					streamedImages.push_back(streamedImage);
+				}
+				pendingCount++;
+
+				{
+					std::lock_guard<std::mutex> lock(queue_lock);
+					jobs.push({ priority, sequence++, name, format, generateMipmaps, streamedImage, nullptr });
+					ScheduleDecodeJobs();
+				}
+
+				return streamedImage;
+			}
+
+			/// <summary>Queues raw asset data (SPIR-V, meshes, etc.) for reading in a decode job, higher priorities are loaded first.</summary>
+			std::shared_future<std::vector<uint8_t>> RequestData(const std::string& name, int32_t priority = 0) {
+				auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+				std::shared_future<std::vector<uint8_t>> future = promise->get_future().share();
+				pendingCount++;
+
+				{
+					std::lock_guard<std::mutex> lock(queue_lock);
+					jobs.push({ priority, sequence++, name, VK_FORMAT_UNDEFINED, false, nullptr, promise });
+					ScheduleDecodeJobs();
+				}
+
+				return future;
+			}
+
+			/// <summary>Releases a streamed image handle (any thread): it is deleted by the next ProcessUploads() once loaded or dropped, its image once the GPU is done with it.</summary>
+			void ReleaseImage(TinyVkStreamedImage* streamedImage) {
+				if (streamedImage == nullptr || streamedImage->released.exchange(true)) return;
+				releasedCount++;
+			}
+
+			/// <summary>Retires finished uploads and submits decoded images (up to maxUploadBytes per call) without blocking. Returns the number of images that became ready or failed.</summary>
+			size_t ProcessUploads(VkDeviceSize maxUploadBytes = 16ULL << 20) {
+				size_t completed = RetireBatches();
+				completed += SubmitUploads(maxUploadBytes);
+				DeleteReleasedImages();
+				return completed;
+			}
+
+			/// <summary>Blocks until every requested asset has been loaded (e.g. behind a loading screen). Returns the number of images that became ready or failed.</summary>
+			size_t Flush() {
+				size_t completed = 0;
+
+				while (pendingCount > 0) {
+					completed += ProcessUploads(std::numeric_limits<VkDeviceSize>::max());
+
+					if (!inflightBatches.empty()) {
+						vkWaitForFences(vkdevice.logicalDevice, 1, &inflightBatches.front().fence, VK_TRUE, UINT64_MAX);
+					} else if (pendingCount > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+
+				return completed;
+			}
+
+			/// <summary>Returns the number of requested assets that have not finished loading.</summary>
+			size_t GetPendingCount() { return pendingCount; }
+
+			/// <summary>Returns the number of decoded images waiting for upload.</summary>
+			size_t GetUploadQueueCount() {
+				std::lock_guard<std::mutex> lock(queue_lock);
+				return completedUploads.size();
+			}
+
+			/// <summary>Returns the placeholder image returned by streamed images that are not ready.</summary>
+			TinyVkImage& GetPlaceholder() { return *placeholder; }
+		};
+	}
+
+#endif
@@ -0,0 +1,245 @@
+#pragma once
+#ifndef TINYVK_TINYVKBATCHRENDERER
+#define TINYVK_TINYVKBATCHRENDERER
+	#include "./TinyVulkan.hpp"
+	#include <deque>
+	#include <map>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkBatchRenderer is an offline render-to-file pipeline (thumbnail/sprite-sheet baking):
+				1. Each scene callback is rendered into a TinyVkImageRingRenderer frame (multiple frames in flight).
+				2. Each submitted frame is read back asynchronously by a TinyVkImageReadback.
+				3. Completed readbacks are QOI encoded (images_qoi.h) in TinyVkJobSystem jobs while the GPU renders
+				   the next frames, then streamed to disk as numbered files or as one concatenated stream.
+
+			Output Modes:
+				TINYVK_BATCH_NUMBERED_FILES:		outputPath is a file prefix: "thumbs/frame_" -> "thumbs/frame_000000.qoi", ...
+				TINYVK_BATCH_CONCATENATED_STREAM:	outputPath is a single file of back-to-back QOI images (in scene order).
+
+			Scene callbacks receive the TinyVkImageRenderer of the frame being recorded (for Begin/EndRecordCmdBuffer())
+			and the command pool to lease command buffers from, like the TinyVkImageRenderer::onRenderEvents.
+
+			Only 8-bit 4 channel RGBA/BGRA render target formats are supported (BGRA is swizzled to RGBA by the encode jobs).
+		*/
+
+		enum class TinyVkBatchOutput {
+			TINYVK_BATCH_NUMBERED_FILES,		/// One QOI file per scene named by its scene index.
+			TINYVK_BATCH_CONCATENATED_STREAM	/// One file of all QOI images concatenated in scene order.
+		};
+
+		/// <summary>Offline batch renderer which renders scenes, reads them back and streams them to disk as QOI images.</summary>
+		class TinyVkBatchRenderer : public TinyVkDisposable {
+		private:
+			struct TinyVkBatchFrame {
+				uint64_t index;
+				VkDeviceSize width, height;
+				std::vector<uint8_t> pixels;
+			};
+
+			TinyVkImageRingRenderer* ringRenderer;
+			TinyVkImageReadback* readback;
+			TinyVkCallback<TinyVkImageRenderer&, TinyVkCommandPool&>* currentScene = nullptr;
+			uint64_t currentSceneIndex = 0;
+			VkFormat format;
+			bool swizzleBGRA;
+			size_t maxQueuedFrames;
+
+			TinyVkJobSystem& jobSystem;
+			TinyVkJobCounter encodeJobs;
+			std::mutex batch_lock;
+			std::deque<TinyVkBatchFrame> batchQueue;
+			std::string batchError;
+
+			TinyVkBatchOutput outputMode;
+			std::string outputPath;
+			std::mutex output_lock;
+			std::ofstream outputStream;
+			std::map<uint64_t, std::pair<void*, int>> outputReorder;
+			uint64_t outputNextIndex = 0;
+
+			/// <summary>Returns true if the render target format is supported for QOI encoding.</summary>
+			static bool QueryFormatSupport(VkFormat format, bool& isBGRA) {
+				switch (format) {
+					case VK_FORMAT_R8G8B8A8_UNORM: case VK_FORMAT_R8G8B8A8_SRGB:
+						isBGRA = false;
+						return true;
+					case VK_FORMAT_B8G8R8A8_UNORM: case VK_FORMAT_B8G8R8A8_SRGB:
+						isBGRA = true;
+						return true;
+					default:
+						return false;
+				}
+			}
+
+			/// <summary>Renders the current scene into the ring renderer frame being recorded.</summary>
+			void OnRenderScene(TinyVkCommandPool& commandPool) {
+				if (currentScene != nullptr)
+					currentScene->invoke(ringRenderer->GetFrameRenderer(), commandPool);
+			}
+
+			/// <summary>Copies a completed readback into the encoding queue and queues its encode job.</summary>
+			void OnReadbackComplete(TinyVkReadbackFrame& frame) {
+				TinyVkBatchFrame batchFrame { frame.frameId, frame.width, frame.height, {} };
+				const uint8_t* data = static_cast<const uint8_t*>(frame.data);
+				batchFrame.pixels.assign(data, data + frame.size);
+
+				{
+					std::lock_guard<std::mutex> lock(batch_lock);
+					batchQueue.push_back(std::move(batchFrame));
+				}
+
+				jobSystem.Run([this]() { this->EncodeNext(); }, &encodeJobs);
+			}
+
+			/// <summary>Encode job: swizzles, QOI encodes and writes the oldest queued frame.</summary>
+			void EncodeNext() {
+				std::unique_lock<std::mutex> lock(batch_lock);
+				TinyVkBatchFrame frame = std::move(batchQueue.front());
+				batchQueue.pop_front();
+				lock.unlock();
+
+				EncodeFrame(frame);
+			}
+
+			/// <summary>QOI encodes a frame and writes it to the output.</summary>
+			void EncodeFrame(TinyVkBatchFrame& frame) {
+				if (swizzleBGRA)
+					for (size_t i = 0; i + 3 < frame.pixels.size(); i += 4)
+						std::swap(frame.pixels[i], frame.pixels[i + 2]);
+
+				qoi_desc desc;
+				desc.width = static_cast<unsigned int>(frame.width);
+				desc.height = static_cast<unsigned int>(frame.height);
+				desc.channels = 4;
+				desc.colorspace = (format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_B8G8R8A8_SRGB)? QOI_SRGB : QOI_LINEAR;
+
+				int encodedSize = 0;
+				void* encoded = qoi_encode(frame.pixels.data(), &desc, &encodedSize);
+				if (encoded == nullptr) {
+					// Failed frames are skipped (null data, zero size) but still advance the concatenated stream, RenderBatch() throws the error.
+					SetBatchError("TinyVulkan: Failed to QOI encode batch frame " + std::to_string(frame.index) + "!");
+					encodedSize = 0;
+				}
+
+				if (outputMode == TinyVkBatchOutput::TINYVK_BATCH_NUMBERED_FILES) {
+					if (encodedSize > 0) {
+						std::ofstream file(GetFrameFileName(frame.index), std::ios::binary);
+						if (!file.write(static_cast<const char*>(encoded), encodedSize))
+							SetBatchError("TinyVulkan: Failed to write batch frame " + std::to_string(frame.index) + "!");
+					}
+
+					if (encoded != nullptr) QOI_FREE(encoded);
+					return;
+				}
+
+				// Concatenated streams are written in scene order regardless of which worker finishes first.
+				std::lock_guard<std::mutex> lock(output_lock);
+				outputReorder[frame.index] = { encoded, encodedSize };
+
+				for (auto next = outputReorder.find(outputNextIndex); next != outputReorder.end(); next = outputReorder.find(++outputNextIndex)) {
+					if (next->second.second > 0 && !outputStream.write(static_cast<const char*>(next->second.first), next->second.second))
+						SetBatchError("TinyVulkan: Failed to write batch frame " + std::to_string(next->first) + "!");
+
+					if (next->second.first != nullptr) QOI_FREE(next->second.first);
+					outputReorder.erase(next);
+				}
+			}
+
+			void SetBatchError(const std::string& error) {
+				std::lock_guard<std::mutex> lock(batch_lock);
+				if (batchError.empty()) batchError = error;
+			}
+
+			/// <summary>Returns the numbered output file name of the scene index.</summary>
+			std::string GetFrameFileName(uint64_t index) {
+				std::string number = std::to_string(index);
+				if (number.size() < 6) number.insert(0, 6 - number.size(), '0');
+				return outputPath + number + ".qoi";
+			}
+
+		public:
+			TinyVkVulkanDevice& vkdevice;
+			TinyVkGraphicsPipeline& graphicsPipeline;
+
+			TinyVkBatchRenderer operator=(const TinyVkBatchRenderer& batchRenderer) = delete;
+
+			~TinyVkBatchRenderer() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				jobSystem.Wait(encodeJobs);
+
+				for (auto& reorder : outputReorder)
+					if (reorder.second.first != nullptr) QOI_FREE(reorder.second.first);
+
+				readback->Dispose(waitIdle);
+				delete readback;
+
+				ringRenderer->Dispose(waitIdle);
+				delete ringRenderer;
+			}
+
+			/// <summary>Creates a batch renderer of width x height frames with ringSize frames in flight and up to 2 x workerCount frames queued for QOI encoding jobs (0 = job system worker count).</summary>
+			TinyVkBatchRenderer(TinyVkVulkanDevice& vkdevice, TinyVkGraphicsPipeline& graphicsPipeline, VkDeviceSize width, VkDeviceSize height, size_t ringSize = 3ULL, size_t workerCount = 0ULL, VkFormat format = VK_FORMAT_B8G8R8A8_SRGB, TinyVkJobSystem& jobSystem = TinyVkJobSystem::Default())
+			: vkdevice(vkdevice), graphicsPipeline(graphicsPipeline), format(format), jobSystem(jobSystem), outputMode(TinyVkBatchOutput::TINYVK_BATCH_NUMBERED_FILES) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				if (!QueryFormatSupport(format, swizzleBGRA))
+					throw std::runtime_error("TinyVulkan: TinyVkBatchRenderer only supports 8-bit RGBA/BGRA render target formats!");
+
+				if (workerCount == 0)
+					workerCount = jobSystem.GetWorkerCount();
+
+				maxQueuedFrames = workerCount * 2;
+				ringRenderer = new TinyVkImageRingRenderer(vkdevice, graphicsPipeline, width, height, ringSize, format);
+				readback = new TinyVkImageReadback(vkdevice, graphicsPipeline, ringSize + 1);
+
+				ringRenderer->onRenderEvents.hook(TinyVkCallback<TinyVkCommandPool&>([this](TinyVkCommandPool& commandPool) { this->OnRenderScene(commandPool); }));
+				ringRenderer->onFrameSubmitted.hook(TinyVkCallback<size_t, TinyVkImage&>([this](size_t, TinyVkImage& renderTarget) { this->readback->ReadbackAsync(renderTarget, this->currentSceneIndex); }));
+				readback->onReadbackComplete.hook(TinyVkCallback<TinyVkReadbackFrame&>([this](TinyVkReadbackFrame& frame) { this->OnReadbackComplete(frame); }));
+
+				SetOwner(vkdevice);
+			}
+
+			/// <summary>Returns the underlying ring renderer (e.g. for the render target size/format).</summary>
+			TinyVkImageRingRenderer& GetRingRenderer() { return *ringRenderer; }
+
+			/// <summary>Renders, reads back and QOI encodes every scene to the output. Blocks until every frame is written to disk.</summary>
+			void RenderBatch(const std::vector<TinyVkCallback<TinyVkImageRenderer&, TinyVkCommandPool&>>& scenes, const std::string& outputPath, TinyVkBatchOutput outputMode = TinyVkBatchOutput::TINYVK_BATCH_NUMBERED_FILES) {
+				this->outputPath = outputPath;
+				this->outputMode = outputMode;
+				outputNextIndex = 0;
+				batchError.clear();
+
+				if (outputMode == TinyVkBatchOutput::TINYVK_BATCH_CONCATENATED_STREAM) {
+					outputStream.open(outputPath, std::ios::binary | std::ios::trunc);
+					if (!outputStream.is_open())
+						throw std::runtime_error("TinyVulkan: Failed to open batch output stream: " + outputPath);
+				}
+
+				for (size_t i = 0; i < scenes.size(); i++) {
+					TinyVkCallback<TinyVkImageRenderer&, TinyVkCommandPool&> scene = scenes[i];
+					currentScene = &scene;
+					currentSceneIndex = i;
+
+					// Back-pressure: help encoding before capturing the next frame if the encode jobs are too far behind.
+					jobSystem.Wait(encodeJobs, maxQueuedFrames - 1);
+					ringRenderer->RenderExecute();
+					readback->Poll();
+				}
+
+				currentScene = nullptr;
+				readback->Flush();
+
+				jobSystem.Wait(encodeJobs);
+
+				if (outputStream.is_open())
+					outputStream.close();
+
+				if (!batchError.empty())
+					throw std::runtime_error(batchError);
+			}
+		};
+	}
+
+#endif
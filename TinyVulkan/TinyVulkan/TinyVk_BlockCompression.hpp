@@ -0,0 +1,467 @@
+#pragma once
+#ifndef TINYVK_TINYVKBLOCKCOMPRESSION
+#define TINYVK_TINYVKBLOCKCOMPRESSION
+	#include "./TinyVulkan.hpp"
+	#include <cmath>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkBlockEncoder transcodes RGBA8 pixels (e.g. decoded QOI images) into GPU block-compressed 4x4 texel
+			blocks of 16 bytes (1 byte per texel instead of 4) for offline packing (see AssetPacker --bc7/--etc2):
+				BC7 (VK_FORMAT_BC7_*_BLOCK):					mode 6 (single subset RGBA, 7.7.7.7 + p-bit endpoints,
+																4-bit indices), principal axis fit + least squares refinement.
+				ETC2 RGBA8 (VK_FORMAT_ETC2_R8G8B8A8_*_BLOCK):	EAC alpha + ETC1 individual/differential color blocks
+																(always decodable as ETC2, the T/H/planar modes are not used).
+
+			BC7 is supported on desktop GPUs (textureCompressionBC), ETC2 on mobile GPUs (textureCompressionETC2), pick
+			the format at runtime with TinyVkVulkanDevice::QueryCompressedFormat(). Partial blocks at the right/bottom edge
+			repeat the edge texels. The encoders favour speed over quality--use a dedicated encoder for final assets.
+		*/
+
+		/// <summary>CPU transcoder from RGBA8 pixels into BC7 or ETC2 RGBA8 blocks.</summary>
+		class TinyVkBlockEncoder {
+		private:
+			static constexpr int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+			static constexpr int ETC_MODIFIERS[8][2] = { {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183} };
+			static constexpr int EAC_MODIFIERS[16][8] = {
+				{-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12}, {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+				{-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10}, {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+				{-2, -6, -8, -10, 1, 5, 7, 9}, {-2, -5, -8, -10, 1, 4, 7, 9}, {-2, -4, -8, -10, 1, 3, 7, 9}, {-2, -5, -7, -10, 1, 4, 6, 9},
+				{-3, -4, -7, -10, 2, 3, 6, 9}, {-1, -2, -3, -10, 0, 1, 2, 9}, {-4, -6, -8, -9, 3, 5, 7, 8}, {-3, -5, -7, -9, 2, 4, 6, 8}
+			};
+
+			/// <summary>Loads the 4x4 RGBA block at block coordinates (bx, by), repeating edge texels for partial blocks.</summary>
+			static void LoadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, uint8_t block[16][4]) {
+				for (uint32_t y = 0; y < 4; y++)
+					for (uint32_t x = 0; x < 4; x++) {
+						size_t sx = std::min(bx * 4 + x, width - 1), sy = std::min(by * 4 + y, height - 1);
+						std::memcpy(block[y * 4 + x], rgba + (sy * width + sx) * 4, 4);
+					}
+			}
+
+			static void WriteBigEndian64(uint8_t* bytes, uint64_t value) {
+				for (size_t i = 0; i < 8; i++) bytes[i] = static_cast<uint8_t>(value >> ((7 - i) * 8));
+			}
+
+			/// <summary>Quantizes a BC7 mode 6 endpoint into 7-bit channels plus the p-bit with the least error.</summary>
+			static void QuantizeBC7Endpoint(const float endpoint[4], int quantized[4], int& pbit) {
+				float bestError = FLT_MAX;
+				for (int p = 0; p < 2; p++) {
+					float error = 0.0f;
+					int q[4];
+					for (int c = 0; c < 4; c++) {
+						q[c] = std::clamp(static_cast<int>(std::lround((endpoint[c] - p) * 0.5f)), 0, 127);
+						float delta = static_cast<float>((q[c] << 1) | p) - endpoint[c];
+						error += delta * delta;
+					}
+
+					if (error < bestError) {
+						bestError = error;
+						pbit = p;
+						std::memcpy(quantized, q, sizeof(q));
+					}
+				}
+			}
+
+			/// <summary>Selects the closest of the 16 interpolated colors for every texel. Returns the squared error.</summary>
+			static uint32_t SelectBC7Indices(const uint8_t block[16][4], const int q0[4], int p0, const int q1[4], int p1, uint8_t indices[16]) {
+				int palette[16][4];
+				for (int i = 0; i < 16; i++)
+					for (int c = 0; c < 4; c++) {
+						int e0 = (q0[c] << 1) | p0, e1 = (q1[c] << 1) | p1;
+						palette[i][c] = ((64 - BC7_WEIGHTS[i]) * e0 + BC7_WEIGHTS[i] * e1 + 32) >> 6;
+					}
+
+				uint32_t totalError = 0;
+				for (int t = 0; t < 16; t++) {
+					uint32_t bestError = UINT32_MAX;
+					for (int i = 0; i < 16; i++) {
+						uint32_t error = 0;
+						for (int c = 0; c < 4; c++) {
+							int delta = palette[i][c] - block[t][c];
+							error += delta * delta;
+						}
+
+						if (error < bestError) {
+							bestError = error;
+							indices[t] = static_cast<uint8_t>(i);
+						}
+					}
+
+					totalError += bestError;
+				}
+
+				return totalError;
+			}
+
+			/// <summary>Encodes a 4x4 RGBA block as a 16 byte BC7 mode 6 block.</summary>
+			static void EncodeBC7Block(const uint8_t block[16][4], uint8_t* output) {
+				float mean[4] = { 0, 0, 0, 0 }, covariance[4][4] = {};
+				for (int t = 0; t < 16; t++)
+					for (int c = 0; c < 4; c++) mean[c] += block[t][c] / 16.0f;
+
+				for (int t = 0; t < 16; t++)
+					for (int i = 0; i < 4; i++)
+						for (int j = 0; j < 4; j++)
+							covariance[i][j] += (block[t][i] - mean[i]) * (block[t][j] - mean[j]);
+
+				float axis[4] = { 1, 1, 1, 1 };
+				for (int iteration = 0; iteration < 8; iteration++) {
+					float next[4] = { 0, 0, 0, 0 }, length = 0.0f;
+					for (int i = 0; i < 4; i++) {
+						for (int j = 0; j < 4; j++) next[i] += covariance[i][j] * axis[j];
+						length = std::max(length, std::abs(next[i]));
+					}
+
+					if (length < 1e-6f) break;
+					for (int i = 0; i < 4; i++) axis[i] = next[i] / length;
+				}
+
+				float minT = FLT_MAX, maxT = -FLT_MAX, axisLength = 0.0f;
+				for (int c = 0; c < 4; c++) axisLength += axis[c] * axis[c];
+				for (int c = 0; c < 4; c++) axis[c] /= std::sqrt(axisLength);
+
+				for (int t = 0; t < 16; t++) {
+					float projection = 0.0f;
+					for (int c = 0; c < 4; c++) projection += (block[t][c] - mean[c]) * axis[c];
+					minT = std::min(minT, projection);
+					maxT = std::max(maxT, projection);
+				}
+
+				float endpoints[2][4];
+				for (int c = 0; c < 4; c++) {
+					endpoints[0][c] = std::clamp(mean[c] + minT * axis[c], 0.0f, 255.0f);
+					endpoints[1][c] = std::clamp(mean[c] + maxT * axis[c], 0.0f, 255.0f);
+				}
+
+				int q[2][4], p[2];
+				uint8_t indices[16];
+				QuantizeBC7Endpoint(endpoints[0], q[0], p[0]);
+				QuantizeBC7Endpoint(endpoints[1], q[1], p[1]);
+				uint32_t bestError = SelectBC7Indices(block, q[0], p[0], q[1], p[1], indices);
+
+				// Least squares refinement of the endpoints for the selected interpolation weights.
+				for (int iteration = 0; iteration < 2 && bestError > 0; iteration++) {
+					float a = 0, b = 0, d = 0, x0[4] = {}, x1[4] = {};
+					for (int t = 0; t < 16; t++) {
+						float w = BC7_WEIGHTS[indices[t]] / 64.0f;
+						a += (1 - w) * (1 - w);
+						b += (1 - w) * w;
+						d += w * w;
+						for (int c = 0; c < 4; c++) {
+							x0[c] += (1 - w) * block[t][c];
+							x1[c] += w * block[t][c];
+						}
+					}
+
+					float determinant = a * d - b * b;
+					if (std::abs(determinant) < 1e-6f) break;
+
+					for (int c = 0; c < 4; c++) {
+						endpoints[0][c] = std::clamp((d * x0[c] - b * x1[c]) / determinant, 0.0f, 255.0f);
+						endpoints[1][c] = std::clamp((a * x1[c] - b * x0[c]) / determinant, 0.0f, 255.0f);
+					}
+
+					int rq[2][4], rp[2];
+					uint8_t refinedIndices[16];
+					QuantizeBC7Endpoint(endpoints[0], rq[0], rp[0]);
+					QuantizeBC7Endpoint(endpoints[1], rq[1], rp[1]);
+					uint32_t error = SelectBC7Indices(block, rq[0], rp[0], rq[1], rp[1], refinedIndices);
+					if (error >= bestError) break;
+
+					bestError = error;
+					std::memcpy(q, rq, sizeof(q));
+					std::memcpy(p, rp, sizeof(p));
+					std::memcpy(indices, refinedIndices, sizeof(indices));
+				}
+
+				// The anchor (first) index has an implicit 0 MSB: swap the endpoints if it is set.
+				if (indices[0] & 8) {
+					std::swap(q[0], q[1]);
+					std::swap(p[0], p[1]);
+					for (int t = 0; t < 16; t++) indices[t] = static_cast<uint8_t>(15 - indices[t]);
+				}
+
+				uint64_t bits[2] = { 0, 0 };
+				int position = 0;
+				auto write = [&](uint64_t value, int count) {
+					for (int i = 0; i < count; i++, position++)
+						bits[position >> 6] |= ((value >> i) & 1ULL) << (position & 63);
+				};
+
+				write(1 << 6, 7);
+				for (int c = 0; c < 4; c++) {
+					write(q[0][c], 7);
+					write(q[1][c], 7);
+				}
+
+				write(p[0], 1);
+				write(p[1], 1);
+				write(indices[0], 3);
+				for (int t = 1; t < 16; t++) write(indices[t], 4);
+
+				for (int i = 0; i < 16; i++) output[i] = static_cast<uint8_t>(bits[i >> 3] >> ((i & 7) * 8));
+			}
+
+			/// <summary>Encodes the alpha channel of a 4x4 block as a 64-bit EAC alpha block.</summary>
+			static uint64_t EncodeEACAlpha(const uint8_t block[16][4]) {
+				int minAlpha = 255, maxAlpha = 0;
+				for (int t = 0; t < 16; t++) {
+					minAlpha = std::min(minAlpha, static_cast<int>(block[t][3]));
+					maxAlpha = std::max(maxAlpha, static_cast<int>(block[t][3]));
+				}
+
+				int bestBase = minAlpha, bestMultiplier = 1, bestTable = 13;
+				uint32_t bestError = UINT32_MAX;
+
+				for (int table = 0; table < 16 && bestError > 0; table++) {
+					const int* modifiers = EAC_MODIFIERS[table];
+					int range = modifiers[7] - modifiers[3];
+					int multiplierGuess = std::max(1, (maxAlpha - minAlpha + range / 2) / range);
+
+					for (int multiplier = std::max(1, multiplierGuess - 1); multiplier <= std::min(15, multiplierGuess + 1); multiplier++) {
+						int lowBase = minAlpha - modifiers[3] * multiplier, highBase = maxAlpha - modifiers[7] * multiplier;
+						int centerBase = (lowBase + highBase) / 2;
+						const int bases[5] = { lowBase, highBase, centerBase - 1, centerBase, centerBase + 1 };
+
+						for (int candidate : bases) {
+							int base = std::clamp(candidate, 0, 255);
+							uint32_t error = 0;
+							for (int t = 0; t < 16 && error < bestError; t++) {
+								int bestDelta = INT32_MAX;
+								for (int i = 0; i < 8; i++) bestDelta = std::min(bestDelta, std::abs(std::clamp(base + modifiers[i] * multiplier, 0, 255) - block[t][3]));
+								error += bestDelta * bestDelta;
+							}
+
+							if (error < bestError) {
+								bestError = error;
+								bestBase = base;
+								bestMultiplier = multiplier;
+								bestTable = table;
+							}
+						}
+					}
+				}
+
+				uint64_t bits = (static_cast<uint64_t>(bestBase) << 56) | (static_cast<uint64_t>(bestMultiplier) << 52) | (static_cast<uint64_t>(bestTable) << 48);
+				for (int x = 0; x < 4; x++)
+					for (int y = 0; y < 4; y++) {
+						int alpha = block[y * 4 + x][3], bestIndex = 0, bestDelta = INT32_MAX;
+						for (int i = 0; i < 8; i++) {
+							int delta = std::abs(std::clamp(bestBase + EAC_MODIFIERS[bestTable][i] * bestMultiplier, 0, 255) - alpha);
+							if (delta < bestDelta) {
+								bestDelta = delta;
+								bestIndex = i;
+							}
+						}
+
+						bits |= static_cast<uint64_t>(bestIndex) << (45 - 3 * (x * 4 + y));
+					}
+
+				return bits;
+			}
+
+			/// <summary>Selects the modifier table and texel indices of an ETC1 sub-block for a base color. Returns the squared error.</summary>
+			static uint32_t SelectETCSubBlock(const uint8_t block[16][4], const int texels[8], const int base[3], int& table, uint32_t& indexBits) {
+				uint32_t bestError = UINT32_MAX;
+				for (int candidate = 0; candidate < 8; candidate++) {
+					const int modifiers[4] = { ETC_MODIFIERS[candidate][0], ETC_MODIFIERS[candidate][1], -ETC_MODIFIERS[candidate][0], -ETC_MODIFIERS[candidate][1] };
+					uint32_t error = 0, bits = 0;
+
+					for (int i = 0; i < 8 && error < bestError; i++) {
+						const uint8_t* texel = block[texels[i]];
+						uint32_t bestTexelError = UINT32_MAX;
+						int bestIndex = 0;
+
+						for (int m = 0; m < 4; m++) {
+							uint32_t texelError = 0;
+							for (int c = 0; c < 3; c++) {
+								int delta = std::clamp(base[c] + modifiers[m], 0, 255) - texel[c];
+								texelError += delta * delta;
+							}
+
+							if (texelError < bestTexelError) {
+								bestTexelError = texelError;
+								bestIndex = m;
+							}
+						}
+
+						int position = (texels[i] % 4) * 4 + (texels[i] / 4);
+						bits |= ((bestIndex >> 1) << (16 + position)) | ((bestIndex & 1) << position);
+						error += bestTexelError;
+					}
+
+					if (error < bestError) {
+						bestError = error;
+						table = candidate;
+						indexBits = bits;
+					}
+				}
+
+				return bestError;
+			}
+
+			/// <summary>Encodes the color channels of a 4x4 block as a 64-bit ETC1 (ETC2 compatible) block.</summary>
+			static uint64_t EncodeETCColor(const uint8_t block[16][4]) {
+				uint64_t bestBits = 0;
+				uint32_t bestError = UINT32_MAX;
+
+				for (int flip = 0; flip < 2; flip++) {
+					int texels[2][8];
+					float average[2][3] = {};
+					for (int t = 0, counts[2] = { 0, 0 }; t < 16; t++) {
+						int subBlock = (flip) ? (t / 4) / 2 : (t % 4) / 2;
+						texels[subBlock][counts[subBlock]++] = t;
+						for (int c = 0; c < 3; c++) average[subBlock][c] += block[t][c] / 8.0f;
+					}
+
+					for (int differential = 0; differential < 2; differential++) {
+						int quantized[2][3], base[2][3];
+						bool valid = true;
+
+						for (int s = 0; s < 2; s++)
+							for (int c = 0; c < 3; c++) {
+								if (differential) {
+									quantized[s][c] = std::clamp(static_cast<int>(std::lround(average[s][c] * 31.0f / 255.0f)), 0, 31);
+									base[s][c] = (quantized[s][c] << 3) | (quantized[s][c] >> 2);
+								} else {
+									quantized[s][c] = std::clamp(static_cast<int>(std::lround(average[s][c] * 15.0f / 255.0f)), 0, 15);
+									base[s][c] = (quantized[s][c] << 4) | quantized[s][c];
+								}
+							}
+
+						if (differential)
+							for (int c = 0; c < 3; c++) valid &= (quantized[1][c] - quantized[0][c] >= -4 && quantized[1][c] - quantized[0][c] <= 3);
+
+						if (!valid) continue;
+
+						int tables[2];
+						uint32_t indexBits[2];
+						uint32_t error = SelectETCSubBlock(block, texels[0], base[0], tables[0], indexBits[0]);
+						error += SelectETCSubBlock(block, texels[1], base[1], tables[1], indexBits[1]);
+						if (error >= bestError) continue;
+
+						uint64_t bits = 0;
+						for (int c = 0; c < 3; c++) {
+							int shift = 56 - c * 8;
+							if (differential) {
+								bits |= static_cast<uint64_t>(quantized[0][c]) << (shift + 3);
+								bits |= static_cast<uint64_t>((quantized[1][c] - quantized[0][c]) & 7) << shift;
+							} else {
+								bits |= static_cast<uint64_t>(quantized[0][c]) << (shift + 4);
+								bits |= static_cast<uint64_t>(quantized[1][c]) << shift;
+							}
+						}
+
+						bits |= (static_cast<uint64_t>(tables[0]) << 37) | (static_cast<uint64_t>(tables[1]) << 34);
+						bits |= (static_cast<uint64_t>(differential) << 33) | (static_cast<uint64_t>(flip) << 32);
+						bits |= indexBits[0] | indexBits[1];
+
+						bestError = error;
+						bestBits = bits;
+					}
+				}
+
+				return bestBits;
+			}
+
+		public:
+			/// <summary>Returns true if the format can be encoded by the TinyVkBlockEncoder.</summary>
+			static bool IsEncodableFormat(VkFormat format) {
+				switch (format) {
+					case VK_FORMAT_BC7_UNORM_BLOCK: case VK_FORMAT_BC7_SRGB_BLOCK:
+					case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK: case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+						return true;
+					default:
+						return false;
+				}
+			}
+
+			/// <summary>Returns the size in bytes of width x height texels encoded as 4x4 blocks of 16 bytes.</summary>
+			static size_t GetEncodedSize(uint32_t width, uint32_t height) {
+				return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 16;
+			}
+
+			/// <summary>Encodes width x height RGBA8 pixels into the blocks (GetEncodedSize() bytes, row-major) of an encodable format.</summary>
+			static void EncodeInto(VkFormat format, const void* rgba, uint32_t width, uint32_t height, void* blocks, size_t blocksSize, size_t threadCount = 0) {
+				if (!IsEncodableFormat(format))
+					throw std::runtime_error("TinyVulkan: TinyVkBlockEncoder only encodes BC7 and ETC2 RGBA8 formats!");
+
+				if (width == 0 || height == 0 || blocksSize < GetEncodedSize(width, height))
+					throw std::runtime_error("TinyVulkan: TinyVkBlockEncoder image is empty or the block buffer is too small!");
+
+				const uint8_t* pixels = static_cast<const uint8_t*>(rgba);
+				uint8_t* output = static_cast<uint8_t*>(blocks);
+				uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+				bool bc7 = (format == VK_FORMAT_BC7_UNORM_BLOCK || format == VK_FORMAT_BC7_SRGB_BLOCK);
+
+				TinyVkTiledQoi::ParallelFor(blocksY, TinyVkTiledQoi::GetThreadCount(threadCount), [&](size_t by) {
+					uint8_t block[16][4];
+					for (uint32_t bx = 0; bx < blocksX; bx++) {
+						uint8_t* blockOutput = output + (by * blocksX + bx) * 16;
+						LoadBlock(pixels, width, height, bx, static_cast<uint32_t>(by), block);
+
+						if (bc7) {
+							EncodeBC7Block(block, blockOutput);
+						} else {
+							WriteBigEndian64(blockOutput, EncodeEACAlpha(block));
+							WriteBigEndian64(blockOutput + 8, EncodeETCColor(block));
+						}
+					}
+				});
+			}
+
+			/// <summary>Encodes width x height RGBA8 pixels into the blocks of an encodable format.</summary>
+			static std::vector<uint8_t> Encode(VkFormat format, const void* rgba, uint32_t width, uint32_t height, size_t threadCount = 0) {
+				std::vector<uint8_t> blocks(GetEncodedSize(width, height));
+				EncodeInto(format, rgba, width, height, blocks.data(), blocks.size(), threadCount);
+				return blocks;
+			}
+
+			/// <summary>Halves an RGBA8 image with a 2x2 box filter (in gamma space, odd edges repeat the last texel).</summary>
+			static std::vector<uint8_t> Downsample(const void* rgba, uint32_t width, uint32_t height) {
+				const uint8_t* pixels = static_cast<const uint8_t*>(rgba);
+				uint32_t halfWidth = std::max(1U, width / 2), halfHeight = std::max(1U, height / 2);
+				std::vector<uint8_t> half(static_cast<size_t>(halfWidth) * halfHeight * 4);
+
+				for (uint32_t y = 0; y < halfHeight; y++)
+					for (uint32_t x = 0; x < halfWidth; x++) {
+						size_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+						size_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+						for (size_t c = 0; c < 4; c++) {
+							uint32_t sum = pixels[(y0 * width + x0) * 4 + c] + pixels[(y0 * width + x1) * 4 + c] + pixels[(y1 * width + x0) * 4 + c] + pixels[(y1 * width + x1) * 4 + c];
+							half[(static_cast<size_t>(y) * halfWidth + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+						}
+					}
+
+				return half;
+			}
+
+			/// <summary>Encodes levelCount mip levels (0: full chain down to 1x1) of RGBA8 pixels, tightly packed level 0, 1, 2...</summary>
+			static std::vector<uint8_t> EncodeMipChain(VkFormat format, const void* rgba, uint32_t width, uint32_t height, uint32_t levelCount = 0, size_t threadCount = 0) {
+				uint32_t maxLevels = 1;
+				for (uint32_t extent = std::max(width, height); extent > 1; extent >>= 1) maxLevels++;
+				levelCount = (levelCount == 0) ? maxLevels : std::min(levelCount, maxLevels);
+
+				std::vector<uint8_t> chain, level;
+				const uint8_t* pixels = static_cast<const uint8_t*>(rgba);
+
+				for (uint32_t i = 0; i < levelCount; i++) {
+					size_t offset = chain.size();
+					chain.resize(offset + GetEncodedSize(width, height));
+					EncodeInto(format, pixels, width, height, chain.data() + offset, chain.size() - offset, threadCount);
+
+					if (i + 1 < levelCount) {
+						level = Downsample(pixels, width, height);
+						pixels = level.data();
+						width = std::max(1U, width / 2);
+						height = std::max(1U, height / 2);
+					}
+				}
+
+				return chain;
+			}
+		};
+	}
+
+#endif
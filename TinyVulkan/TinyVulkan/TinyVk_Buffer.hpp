@@ -15,8 +15,9 @@
 					Uniform:	Allows you to send data to shaders using uniforms.
 						* Push Constants are an alternative that do not require buffers, simply use: vkCmdPushConstants(...).
 
-				The last buffer type is a CPU memory buffer for transfering data from the CPU to the GPU:
+				The last buffer types are CPU memory buffers for transfering data between the CPU and the GPU:
 					Staging:	Staging CPU data for transfer to the GPU.
+					Readback:	Host-cached persistently mapped memory for reading GPU data back on the CPU.
 
 				Render images are for rendering sprites or textures on the GPU (similar to the swap chain, but handled manually).
 					The default image layout is: VK_IMAGE_LAYOUT_UNDEFINED
@@ -31,6 +32,7 @@
 			VKVMA_BUFFER_TYPE_UNIFORM,	/// For passing uniform/shader variable data to shaders.
 			VKVMA_BUFFER_TYPE_STAGING,	/// For tranfering CPU bound buffer data to the GPU.
 			VKVMA_BUFFER_TYPE_INDIRECT,	/// For writing VkIndirectCommand's to a buffer for Indirect drawing.
+			VKVMA_BUFFER_TYPE_READBACK,	/// For tranfering GPU bound image/buffer data back to the CPU (host-cached, persistently mapped).
 		};
 
 		/// <summary>GPU device Buffer for sending data to the render (GPU) device.</summary>
@@ -50,7 +52,7 @@
 			}
 		
 		public:
-			std::timed_mutex buffer_lock;
+			TinyVkSpinMutex buffer_lock;
 
 			TinyVkVulkanDevice& vkdevice;
 			TinyVkGraphicsPipeline& graphicsPipeline;
@@ -64,9 +66,13 @@
 			~TinyVkBuffer() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
-				if (waitIdle) vkdevice.DeviceWaitIdle();
+				VmaAllocator allocator = vkdevice.GetAllocator();
+				VkBuffer buffer = this->buffer;
+				VmaAllocation memory = this->memory;
 
-				vmaDestroyBuffer(vkdevice.GetAllocator(), buffer, memory);
+				if (waitIdle) {
+					vkdevice.deletionQueue.Enqueue([allocator, buffer, memory]() { vmaDestroyBuffer(allocator, buffer, memory); });
+				} else vmaDestroyBuffer(allocator, buffer, memory);
 			}
 
 			/// <summary>Creates a VkBuffer of the specified size in bytes with manually-set VMA memory allocation properties.</summary>
@@ -75,6 +81,8 @@
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
 
 				CreateBuffer(size, usage, flags);
+
+				SetOwner(vkdevice);
 			}
 
 			/// <summary>Creates a VkBuffer of the specified size in bytes with auto-set memory allocation properties by TinyVkBufferType.</summary>
@@ -95,11 +103,16 @@
 					case TinyVkBufferType::VKVMA_BUFFER_TYPE_INDIRECT:
 					CreateBuffer(size, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT);
 					break;
+					case TinyVkBufferType::VKVMA_BUFFER_TYPE_READBACK:
+					CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+					break;
 					case TinyVkBufferType::VKVMA_BUFFER_TYPE_STAGING:
 					default:
 					CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
 					break;
 				}
+
+				SetOwner(vkdevice);
 			}
 
 			TinyVkBuffer operator=(const TinyVkBuffer& buffer) = delete;
@@ -109,7 +122,7 @@
 				TinyVkBuffer stagingBuffer = TinyVkBuffer(vkdevice, graphicsPipeline, commandPool, dataSize, TinyVkBufferType::VKVMA_BUFFER_TYPE_STAGING);
 				memcpy(stagingBuffer.description.pMappedData, data, (size_t)dataSize);
 				TransferBufferCmd(stagingBuffer, size, srcOffset, dstOffset);
-				stagingBuffer.Dispose();
+				stagingBuffer.Dispose(false); // EndTransferCmd() has already waited on the transfer.
 			}
 
 			/// <summary>Copies data from the source TinyVkBuffer into this TinyVkBuffer.</summary>
@@ -153,5 +166,59 @@
 			/// <summary>Creates the data descriptor that represents this buffer when passing into graphicspipeline.SelectWrite*Descriptor().</summary>
 			VkDescriptorBufferInfo GetBufferDescriptor(VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE) { return { buffer, offset, range }; }
 		};
+
+		/// <summary>Reusable persistently mapped staging buffer which grows on demand, shared by the uploads of any number of TinyVkImages (see TinyVkImage::SetStagingBuffer()).</summary>
+		class TinyVkStagingBuffer : public TinyVkDisposable {
+		private:
+			TinyVkBuffer* buffer = nullptr;
+
+		public:
+			/// Serializes the uploads which share this staging buffer (held while the buffer is written and transferred).
+			TinyVkSpinMutex staging_lock;
+
+			TinyVkVulkanDevice& vkdevice;
+			TinyVkGraphicsPipeline& graphicsPipeline;
+			TinyVkCommandPool& commandPool;
+
+			TinyVkStagingBuffer(const TinyVkStagingBuffer&) = delete;
+			TinyVkStagingBuffer& operator=(const TinyVkStagingBuffer&) = delete;
+
+			~TinyVkStagingBuffer() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				delete buffer; // Already disposed as a child of this staging buffer.
+				buffer = nullptr;
+			}
+
+			/// <summary>Creates a staging buffer (allocated on first use unless initialSize > 0).</summary>
+			TinyVkStagingBuffer(TinyVkVulkanDevice& vkdevice, TinyVkGraphicsPipeline& graphicsPipeline, TinyVkCommandPool& commandPool, VkDeviceSize initialSize = 0)
+			: vkdevice(vkdevice), graphicsPipeline(graphicsPipeline), commandPool(commandPool) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				SetOwner(vkdevice);
+				if (initialSize > 0) Reserve(initialSize);
+			}
+
+			/// <summary>Returns the staging buffer grown to at least dataSize bytes (at least doubling), call with the staging_lock held.</summary>
+			TinyVkBuffer& Reserve(VkDeviceSize dataSize) {
+				if (buffer != nullptr && buffer->size >= dataSize) return *buffer;
+
+				VkDeviceSize size = (buffer != nullptr) ? std::max(dataSize, buffer->size * 2) : dataSize;
+				if (buffer != nullptr) {
+					buffer->Dispose(false); // Uploads wait for their transfer before releasing the staging_lock.
+					delete buffer;
+				}
+
+				buffer = new TinyVkBuffer(vkdevice, graphicsPipeline, commandPool, size, TinyVkBufferType::VKVMA_BUFFER_TYPE_STAGING);
+				buffer->SetOwner(*this);
+				return *buffer;
+			}
+
+			/// <summary>Returns the current size of the staging buffer in bytes (0 until first used).</summary>
+			VkDeviceSize GetSize() {
+				TinyVkLockGuard g(staging_lock);
+				return (buffer != nullptr) ? buffer->size : 0;
+			}
+		};
 	}
 #endif
\ No newline at end of file
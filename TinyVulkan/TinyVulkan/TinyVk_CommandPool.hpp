@@ -49,9 +49,12 @@
 			~TinyVkCommandPool() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
-				if (waitIdle) vkDeviceWaitIdle(vkdevice.GetLogicalDevice());
+				VkDevice logicalDevice = vkdevice.GetLogicalDevice();
+				VkCommandPool commandPool = this->commandPool;
 
-				vkDestroyCommandPool(vkdevice.GetLogicalDevice(), commandPool, nullptr);
+				if (waitIdle) {
+					vkdevice.deletionQueue.Enqueue([logicalDevice, commandPool]() { vkDestroyCommandPool(logicalDevice, commandPool, nullptr); });
+				} else vkDestroyCommandPool(logicalDevice, commandPool, nullptr);
 			}
 			
 			/// <summary>Creates a command pool to lease VkCommandBuffers from for recording render commands.</summary>
@@ -60,6 +63,8 @@
 
 				CreateCommandPool();
 				CreateCommandBuffers(bufferCount+1);
+
+				SetOwner(vkdevice);
 			}
 
 			/// <summary>Returns the underlying VkCommandPool.</summary>
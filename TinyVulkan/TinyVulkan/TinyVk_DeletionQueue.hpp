@@ -0,0 +1,156 @@
+#pragma once
+#ifndef TINYVK_TINYVKDELETIONQUEUE
+#define TINYVK_TINYVKDELETIONQUEUE
+	#include "./TinyVulkan.hpp"
+	#include <deque>
+	#include <functional>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkDeletionQueue defers the destruction of GPU resources until the GPU has retired every
+			queue submission that may still reference them, instead of calling vkDeviceWaitIdle() on Dispose().
+
+			Renderers report each queue submission with SignalSubmission(fence), which returns a monotonic
+			submission (timeline) value. Enqueue(destructor) tags the destructor with the latest submission
+			value and Collect() runs every destructor whose submission has been retired by the GPU.
+
+			All TinyVulkan submissions go through the graphics queue, which retires in submission order, so
+			once any tracked fence signals every submission before it has also been retired.
+
+			Resources must not be disposed while a command buffer that references them is still being recorded
+			(this was already invalid under vkDeviceWaitIdle, as destroying the resource invalidates the command buffer).
+		*/
+
+		/// <summary>Per-frame deferred deletion queue for GPU resources keyed to submission fences and timeline values.</summary>
+		class TinyVkDeletionQueue {
+		private:
+			struct TinyVkSubmission { uint64_t value; VkFence fence; };
+			struct TinyVkDeletion { uint64_t value; std::function<void()> destructor; };
+
+			TinyVkSpinMutex queue_lock;
+			VkDevice& logicalDevice;
+			uint64_t submittedValue = 0;
+			uint64_t retiredValue = 0;
+			std::deque<TinyVkSubmission> submissions;
+			std::deque<TinyVkDeletion> deletions;
+			std::vector<std::function<void()>> retiredDeletions;
+
+			/// <summary>Advances the retired value to the newest signaled submission and drops retired submissions.</summary>
+			void RetireSubmissions() {
+				for (auto submission = submissions.rbegin(); submission != submissions.rend(); submission++)
+					if (vkGetFenceStatus(logicalDevice, submission->fence) == VK_SUCCESS) {
+						retiredValue = std::max(retiredValue, submission->value);
+						break;
+					}
+
+				while (!submissions.empty() && submissions.front().value <= retiredValue)
+					submissions.pop_front();
+
+				if (submissions.empty())
+					retiredValue = submittedValue;
+			}
+
+			/// <summary>Moves every deletion whose submission value has been retired into the retiredDeletions list.</summary>
+			void RetireDeletions() {
+				while (!deletions.empty() && deletions.front().value <= retiredValue) {
+					retiredDeletions.push_back(std::move(deletions.front().destructor));
+					deletions.pop_front();
+				}
+			}
+
+			/// <summary>Executes (outside of the queue lock) and clears the list of retired deletions.</summary>
+			void ExecuteDeletions(std::vector<std::function<void()>>& retired) {
+				for (auto& destructor : retired) destructor();
+				retired.clear();
+			}
+
+		public:
+			TinyVkDeletionQueue operator=(const TinyVkDeletionQueue&) = delete;
+
+			/// <summary>Creates a deletion queue for the logical device (the handle is read on use, so it may be created later).</summary>
+			TinyVkDeletionQueue(VkDevice& logicalDevice) : logicalDevice(logicalDevice) {}
+
+			/// <summary>Registers a queue submission signaling the fence and returns its submission (timeline) value.</summary>
+			uint64_t SignalSubmission(VkFence fence) {
+				TinyVkLockGuard g(queue_lock);
+				submissions.push_back({ ++submittedValue, fence });
+				return submittedValue;
+			}
+
+			/// <summary>Forgets a tracked fence before it is destroyed. The caller guarantees the GPU is done with the fence.</summary>
+			void RetireFence(VkFence fence) {
+				TinyVkLockGuard g(queue_lock);
+				for (const TinyVkSubmission& submission : submissions)
+					if (submission.fence == fence)
+						retiredValue = std::max(retiredValue, submission.value);
+
+				std::erase_if(submissions, [fence](const TinyVkSubmission& submission) { return submission.fence == fence; });
+				RetireSubmissions();
+			}
+
+			/// <summary>Queues a destructor to run once the GPU retires the latest submission (runs immediately if nothing is in flight).</summary>
+			void Enqueue(std::function<void()> destructor) {
+				TinyVkLockGuard g(queue_lock);
+				RetireSubmissions();
+
+				if (retiredValue >= submittedValue && deletions.empty()) {
+					g.Unlock();
+					destructor();
+					return;
+				}
+
+				deletions.push_back({ submittedValue, std::move(destructor) });
+			}
+
+			/// <summary>Destroys all queued resources whose submissions have been retired by the GPU. Returns the number destroyed.</summary>
+			size_t Collect() {
+				TinyVkLockGuard g(queue_lock);
+				RetireSubmissions();
+				RetireDeletions();
+
+				std::vector<std::function<void()>> retired;
+				retired.swap(retiredDeletions);
+				g.Unlock();
+
+				size_t count = retired.size();
+				ExecuteDeletions(retired);
+				return count;
+			}
+
+			/// <summary>Destroys all queued resources, optionally waiting for the device to finish all work first.</summary>
+			void Flush(bool waitIdle = true) {
+				if (waitIdle) vkDeviceWaitIdle(logicalDevice);
+
+				TinyVkLockGuard g(queue_lock);
+				retiredValue = submittedValue;
+				submissions.clear();
+				RetireDeletions();
+
+				std::vector<std::function<void()>> retired;
+				retired.swap(retiredDeletions);
+				g.Unlock();
+
+				ExecuteDeletions(retired);
+			}
+
+			/// <summary>Returns the value of the latest registered submission.</summary>
+			uint64_t GetSubmittedValue() {
+				TinyVkLockGuard g(queue_lock);
+				return submittedValue;
+			}
+
+			/// <summary>Returns the value of the latest submission known to be retired by the GPU.</summary>
+			uint64_t GetRetiredValue() {
+				TinyVkLockGuard g(queue_lock);
+				return retiredValue;
+			}
+
+			/// <summary>Returns the number of resources waiting to be destroyed.</summary>
+			size_t GetPendingCount() {
+				TinyVkLockGuard g(queue_lock);
+				return deletions.size();
+			}
+		};
+	}
+
+#endif
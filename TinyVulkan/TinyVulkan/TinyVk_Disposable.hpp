@@ -8,21 +8,123 @@
 			#define DISPOSABLE_BOOL_DEFAULT true
 		#endif
 
+		/*
+			Ownership tree: SetOwner(owner) links a disposable to its owner. Dispose() disposes the children of an object
+			first, newest first (objects depend on objects created before them), then the object itself--so disposing an
+			owner tears down everything created from it in dependency order, regardless of the order they are destroyed in.
+
+			The TinyVkVulkanDevice owns the command pools, pipelines, buffers, images, renderers, streamers and atlases
+			created with it. Objects which create their own internal pools/images/buffers adopt themselves at the end of
+			their constructor (after their internal objects), so they are disposed first and dispose their internals themselves.
+			A TinyVkRenderThread is owned by its TinyVkSwapChainRenderer.
+
+			An owner whose Disposable() disposes its children itself sets disposesChildren and calls DisposeChildren():
+			the TinyVkVulkanDevice waits for the device to be idle once, then disposes every child with waitIdle = false
+			(immediate destruction, no per-object fence waits or deletion queue entries) in bulk. Stop threads that submit
+			work (TinyVkRenderThread::Stop()) before disposing the device.
+
+			Destroying a child unlinks it from its owner, destroying an owner orphans its remaining children.
+			The tree is thread-safe, but an object must not be destroyed while its owner is disposing it.
+		*/
+
 		class TinyVkDisposable {
+		private:
+			TinyVkSpinMutex children_lock;
+			/// Owner links, guarded by the children_lock of the owner.
+			std::atomic<TinyVkDisposable*> owner = nullptr;
+			TinyVkDisposable* prevSibling = nullptr;
+			TinyVkDisposable* nextSibling = nullptr;
+			/// Child list, guarded by children_lock.
+			TinyVkDisposable* firstChild = nullptr;
+			TinyVkDisposable* lastChild = nullptr;
+			size_t childCount = 0;
+
+			/// <summary>Removes child from this object's child list (children_lock must be held).</summary>
+			void UnlinkChild(TinyVkDisposable* child) {
+				if (child->prevSibling != nullptr) child->prevSibling->nextSibling = child->nextSibling; else firstChild = child->nextSibling;
+				if (child->nextSibling != nullptr) child->nextSibling->prevSibling = child->prevSibling; else lastChild = child->prevSibling;
+				child->prevSibling = child->nextSibling = nullptr;
+				child->owner.store(nullptr, std::memory_order_release);
+				childCount--;
+			}
+
 		protected:
 			std::atomic_bool disposed = false;
+			/// Set by owners whose Disposable() calls DisposeChildren() itself, else Dispose() disposes the children first.
+			bool disposesChildren = false;
+
+			/// <summary>Disposes every child (newest first) and unlinks them from this object.</summary>
+			void DisposeChildren(bool waitIdle) {
+				while (true) {
+					TinyVkLockGuard g(children_lock);
+					TinyVkDisposable* child = lastChild;
+					if (child == nullptr) return;
+					UnlinkChild(child);
+					g.Unlock();
+
+					child->Dispose(waitIdle);
+				}
+			}
 
 		public:
 			TinyVkInvokable<bool> onDispose;
 
-			void Dispose() {
+			TinyVkDisposable() = default;
+			TinyVkDisposable(const TinyVkDisposable&) = delete;
+			TinyVkDisposable& operator=(const TinyVkDisposable&) = delete;
+
+			~TinyVkDisposable() {
+				ClearOwner();
+
+				TinyVkLockGuard g(children_lock);
+				while (lastChild != nullptr) UnlinkChild(lastChild);
+			}
+
+			void Dispose() { Dispose(DISPOSABLE_BOOL_DEFAULT); }
+
+			/// <summary>Disposes of this object and its children: true defers GPU resource destruction until the GPU is done with them, false destroys them immediately.</summary>
+			void Dispose(bool waitIdle) {
 				if (disposed) return;
-				onDispose.invoke(DISPOSABLE_BOOL_DEFAULT);
+				if (!disposesChildren) DisposeChildren(waitIdle);
+				onDispose.invoke(waitIdle);
 				disposed = true;
 			}
 
 			bool IsDisposed() { return disposed; }
+
+			/// <summary>Makes owner the owner of this object (disposed with and before it), replacing the previous owner.</summary>
+			void SetOwner(TinyVkDisposable& owner) {
+				if (&owner == this) throw std::runtime_error("TinyVulkan: TinyVkDisposable cannot own itself!");
+				ClearOwner();
+
+				TinyVkLockGuard g(owner.children_lock);
+				prevSibling = owner.lastChild;
+				nextSibling = nullptr;
+				if (owner.lastChild != nullptr) owner.lastChild->nextSibling = this; else owner.firstChild = this;
+				owner.lastChild = this;
+				owner.childCount++;
+				this->owner.store(&owner, std::memory_order_release);
+			}
+
+			/// <summary>Unlinks this object from its owner (it is no longer disposed with it).</summary>
+			void ClearOwner() {
+				while (TinyVkDisposable* current = owner.load(std::memory_order_acquire)) {
+					TinyVkLockGuard g(current->children_lock);
+					if (owner.load(std::memory_order_relaxed) != current) continue;
+					current->UnlinkChild(this);
+					return;
+				}
+			}
+
+			/// <summary>Returns the owner of this object (nullptr if it has none).</summary>
+			TinyVkDisposable* GetOwner() { return owner.load(std::memory_order_acquire); }
+
+			/// <summary>Returns the number of objects owned by this object.</summary>
+			size_t GetChildCount() {
+				TinyVkLockGuard g(children_lock);
+				return childCount;
+			}
 		};
 	}
 
-#endif
\ No newline at end of file
+#endif
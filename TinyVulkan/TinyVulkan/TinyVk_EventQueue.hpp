@@ -0,0 +1,236 @@
+#pragma once
+#ifndef TINYVK_TINYVKEVENTQUEUE
+#define TINYVK_TINYVKEVENTQUEUE
+	#include "./TinyVulkan.hpp"
+	#include <initializer_list>
+	#include <memory>
+	#include <tuple>
+
+	#ifndef TINYVK_EVENT_QUEUE_CAPACITY
+		#define TINYVK_EVENT_QUEUE_CAPACITY 256
+	#endif
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			GLFW invokes input/window callbacks on the thread polling events (the main thread), so subscribers that live
+			on a render thread race with it. A TinyVkEventQueue is a TinyVkInvokable that can defer its events instead:
+			in queued mode post() copies the event arguments into a lock-free bounded ring buffer (any number of producer
+			threads) and dispatch() invokes the queued events in order on the consuming thread at a defined point in its
+			frame (see TinyVkWindow::DispatchEvents(), called once per frame by the application).
+
+			Each queue only keeps the order of its own events. A TinyVkEventSequence merges several queues into one order:
+			its queues stamp every queued event with a shared sequence number and dispatch() invokes the oldest event of
+			any queue first, so e.g. a key press and a mouse click are handled in the order they happened. The order across
+			queues is exact for events posted from one thread (GLFW posts every callback from the main thread).
+
+			In immediate mode (default) post() simply invokes the event. Events posted to a full queue are dropped and
+			counted (dropped_count()), raise TINYVK_EVENT_QUEUE_CAPACITY if it is ever non-zero.
+		*/
+
+		/// <summary>Dispatch mode of TinyVkEventQueue events: invoked where posted or queued until dispatched.</summary>
+		enum class TinyVkEventDispatch {
+			TINYVK_EVENT_DISPATCH_IMMEDIATE,
+			TINYVK_EVENT_DISPATCH_QUEUED
+		};
+
+		/// <summary>Bounded lock-free multi-producer/single-consumer ring buffer (per-slot sequence numbers).</summary>
+		template<typename T>
+		class TinyVkRingBuffer {
+		private:
+			struct TinyVkRingSlot {
+				std::atomic<size_t> sequence;
+				T value;
+			};
+
+			std::unique_ptr<TinyVkRingSlot[]> slots;
+			size_t mask;
+			alignas(64) std::atomic<size_t> head = 0;
+			alignas(64) size_t tail = 0;
+
+		public:
+			TinyVkRingBuffer(const TinyVkRingBuffer&) = delete;
+			TinyVkRingBuffer& operator=(const TinyVkRingBuffer&) = delete;
+
+			/// <summary>Creates a ring buffer holding at least capacity values (rounded up to a power of two).</summary>
+			TinyVkRingBuffer(size_t capacity) {
+				size_t size = 2;
+				while (size < capacity) size <<= 1;
+
+				mask = size - 1;
+				slots = std::make_unique<TinyVkRingSlot[]>(size);
+				for (size_t i = 0; i < size; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+
+			/// <summary>Pushes a value (from any thread), returns false if the ring buffer is full.</summary>
+			bool TryPush(const T& value) {
+				size_t position = head.load(std::memory_order_relaxed);
+
+				for (;;) {
+					TinyVkRingSlot& slot = slots[position & mask];
+					intptr_t difference = static_cast<intptr_t>(slot.sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(position);
+
+					if (difference == 0) {
+						if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+							slot.value = value;
+							slot.sequence.store(position + 1, std::memory_order_release);
+							return true;
+						}
+					} else if (difference < 0) {
+						return false;
+					} else position = head.load(std::memory_order_relaxed);
+				}
+			}
+
+			/// <summary>Pops the oldest value (from the single consumer thread), returns false if the ring buffer is empty.</summary>
+			bool TryPop(T& value) {
+				TinyVkRingSlot& slot = slots[tail & mask];
+				if (slot.sequence.load(std::memory_order_acquire) != tail + 1) return false;
+
+				value = std::move(slot.value);
+				slot.sequence.store(tail + mask + 1, std::memory_order_release);
+				tail++;
+				return true;
+			}
+
+			/// <summary>Returns the oldest value without popping it (from the single consumer thread), nullptr if the ring buffer is empty.</summary>
+			const T* TryPeek() const {
+				const TinyVkRingSlot& slot = slots[tail & mask];
+				if (slot.sequence.load(std::memory_order_acquire) != tail + 1) return nullptr;
+				return &slot.value;
+			}
+
+			/// <summary>Returns the number of values the ring buffer can hold.</summary>
+			size_t Capacity() const { return mask + 1; }
+		};
+
+		/// <summary>Type-erased event queue which TinyVkEventSequence merges with other queues in posted order.</summary>
+		class TinyVkEventSource {
+			friend class TinyVkEventSequence;
+
+		protected:
+			/// Shared sequence number of the TinyVkEventSequence this queue belongs to (nullptr if none).
+			std::atomic<uint64_t>* sequence = nullptr;
+
+			/// <summary>Returns the sequence number of the oldest queued event in order (false if no event is queued).</summary>
+			virtual bool peek_order(uint64_t& order) = 0;
+
+			/// <summary>Invokes the oldest queued event, returns false if no event is queued or another thread is dispatching.</summary>
+			virtual bool dispatch_next() = 0;
+
+		public:
+			virtual ~TinyVkEventSource() = default;
+		};
+
+		/// <summary>TinyVkInvokable event that is either invoked when posted or queued and invoked by the consuming thread on dispatch().</summary>
+		template<typename... A>
+		class TinyVkEventQueue : public TinyVkInvokable<A...>, public TinyVkEventSource {
+			static_assert((!std::is_reference_v<A> && ...), "TinyVulkan: TinyVkEventQueue arguments are copied into the queue and cannot be references!");
+
+		private:
+			TinyVkRingBuffer<std::pair<uint64_t, std::tuple<A...>>> events;
+			std::atomic<bool> queued = false;
+			std::atomic_flag dispatching;
+			std::atomic<size_t> dropped = 0;
+
+		protected:
+			bool peek_order(uint64_t& order) override {
+				const std::pair<uint64_t, std::tuple<A...>>* event = events.TryPeek();
+				if (event == nullptr) return false;
+
+				order = event->first;
+				return true;
+			}
+
+			bool dispatch_next() override {
+				if (dispatching.test_and_set(std::memory_order_acquire)) return false;
+				struct TinyVkDispatchGuard { std::atomic_flag& flag; ~TinyVkDispatchGuard() { flag.clear(std::memory_order_release); } } guard { dispatching };
+
+				std::pair<uint64_t, std::tuple<A...>> event;
+				if (!events.TryPop(event)) return false;
+
+				std::apply([this](A&... args) { this->invoke(args...); }, event.second);
+				return true;
+			}
+
+		public:
+			TinyVkEventQueue(size_t capacity = TINYVK_EVENT_QUEUE_CAPACITY) : events(capacity) {}
+
+			/// <summary>Sets the dispatch mode (events already queued still wait for the next dispatch()).</summary>
+			void set_dispatch(TinyVkEventDispatch mode) { queued.store(mode == TinyVkEventDispatch::TINYVK_EVENT_DISPATCH_QUEUED, std::memory_order_release); }
+
+			/// <summary>Returns the current dispatch mode.</summary>
+			TinyVkEventDispatch get_dispatch() const { return (queued.load(std::memory_order_acquire)) ? TinyVkEventDispatch::TINYVK_EVENT_DISPATCH_QUEUED : TinyVkEventDispatch::TINYVK_EVENT_DISPATCH_IMMEDIATE; }
+
+			/// <summary>Invokes the event (immediate mode) or queues it for the next dispatch() (queued mode).</summary>
+			void post(A... args) {
+				if (!queued.load(std::memory_order_acquire)) {
+					this->invoke(args...);
+					return;
+				}
+
+				uint64_t order = (sequence != nullptr) ? sequence->fetch_add(1, std::memory_order_relaxed) : 0;
+				if (!events.TryPush({ order, std::tuple<A...>(args...) }))
+					dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			/// <summary>Invokes every queued event in posted order on the calling thread, returns the number of events dispatched (0 if another thread is already dispatching).</summary>
+			size_t dispatch() {
+				if (dispatching.test_and_set(std::memory_order_acquire)) return 0;
+				struct TinyVkDispatchGuard { std::atomic_flag& flag; ~TinyVkDispatchGuard() { flag.clear(std::memory_order_release); } } guard { dispatching };
+
+				size_t count = 0;
+				std::pair<uint64_t, std::tuple<A...>> event;
+				while (events.TryPop(event)) {
+					std::apply([this](A&... args) { this->invoke(args...); }, event.second);
+					count++;
+				}
+
+				return count;
+			}
+
+			/// <summary>Returns the number of events dropped because the queue was full.</summary>
+			size_t dropped_count() const { return dropped.load(std::memory_order_relaxed); }
+		};
+
+		/// <summary>Merges the queued events of several TinyVkEventQueues into one posted order (dispatch its queues only through it).</summary>
+		class TinyVkEventSequence {
+		private:
+			std::atomic<uint64_t> sequence = 0;
+			std::vector<TinyVkEventSource*> sources;
+			std::atomic_flag dispatching;
+
+		public:
+			TinyVkEventSequence(const TinyVkEventSequence&) = delete;
+			TinyVkEventSequence& operator=(const TinyVkEventSequence&) = delete;
+
+			/// <summary>Creates a sequence of the event queues (create it before queued events are posted to them).</summary>
+			TinyVkEventSequence(std::initializer_list<TinyVkEventSource*> sources) : sources(sources) {
+				for (TinyVkEventSource* source : this->sources)
+					source->sequence = &sequence;
+			}
+
+			/// <summary>Invokes every queued event of every queue in posted order on the calling thread, returns the number of events dispatched (0 if another thread is already dispatching).</summary>
+			size_t dispatch() {
+				if (dispatching.test_and_set(std::memory_order_acquire)) return 0;
+				struct TinyVkDispatchGuard { std::atomic_flag& flag; ~TinyVkDispatchGuard() { flag.clear(std::memory_order_release); } } guard { dispatching };
+
+				size_t count = 0;
+				while (true) {
+					TinyVkEventSource* oldest = nullptr;
+					uint64_t oldestOrder = 0;
+
+					for (TinyVkEventSource* source : sources) {
+						uint64_t order;
+						if (source->peek_order(order) && (oldest == nullptr || order < oldestOrder)) {
+							oldest = source;
+							oldestOrder = order;
+						}
+					}
+
+					if (oldest == nullptr || !oldest->dispatch_next()) return count;
+					count++;
+				}
+			}
+		};
+	}
+#endif
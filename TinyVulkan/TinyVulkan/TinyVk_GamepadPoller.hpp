@@ -0,0 +1,185 @@
+#pragma once
+#ifndef TINYVK_TINYVKGAMEPADPOLLER
+#define TINYVK_TINYVKGAMEPADPOLLER
+	#include "./TinyVulkan.hpp"
+	#include <array>
+	#include <bit>
+	#include <chrono>
+	#include <cmath>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			GLFW has no gamepad events, so gamepads must be polled. TinyVkGamepadPoller only polls the pads it knows are
+			connected (a bitmask kept up to date by SetConnected() from the GLFW joystick callback, seeded by Rescan()),
+			and Poll() can be rate limited with SetPollRate() so it is cheap to call every frame.
+
+			Each axis is filtered in one pass: values within the axis deadzone (around its rest value, -1 for triggers)
+			snap to rest and the remaining range is rescaled, then a change is only reported once it exceeds the axis
+			hysteresis (or returns to rest). All button and axis changes of a pad are batched into a single
+			TinyVkGamepadChanges event per pad per poll (onGamepadChanged). Disconnecting a pad reports a return to rest.
+		*/
+
+		/// <summary>Deadzone and hysteresis of a gamepad axis (rest is -1 for triggers, 0 for sticks).</summary>
+		struct TinyVkGamepadAxisFilter {
+			float_t deadzone = 0.1f;
+			float_t hysteresis = 0.002f;
+			float_t rest = 0.0f;
+		};
+
+		/// <summary>Batched state of a gamepad after a poll: button/axis values and masks of which buttons/axes changed.</summary>
+		struct TinyVkGamepadChanges {
+			uint16_t buttons = 0;
+			uint16_t changedButtons = 0;
+			uint8_t changedAxes = 0;
+			std::array<float_t, GLFW_GAMEPAD_AXIS_LAST + 1> axes {};
+
+			bool IsButtonDown(TinyVkGamepadButtons button) const { return (buttons >> static_cast<int32_t>(button)) & 1U; }
+			bool ButtonChanged(TinyVkGamepadButtons button) const { return (changedButtons >> static_cast<int32_t>(button)) & 1U; }
+			bool AxisChanged(TinyVkGamepadAxis axis) const { return (changedAxes >> static_cast<int32_t>(axis)) & 1U; }
+			float_t GetAxis(TinyVkGamepadAxis axis) const { return axes[static_cast<int32_t>(axis)]; }
+		};
+
+		/// <summary>Polls connected gamepads only, filters their axes and batches their changes into one event per pad per poll.</summary>
+		class TinyVkGamepadPoller {
+		private:
+			static constexpr size_t GamepadCount = GLFW_JOYSTICK_LAST + 1;
+			static constexpr size_t AxisCount = GLFW_GAMEPAD_AXIS_LAST + 1;
+
+			TinyVkSpinMutex poll_lock;
+			std::atomic<uint32_t> connected = 0;
+			std::array<TinyVkGamepadAxisFilter, AxisCount> filters;
+			std::array<TinyVkGamepadChanges, GamepadCount> cache {};
+			std::chrono::steady_clock::duration pollInterval = std::chrono::steady_clock::duration::zero();
+			std::chrono::steady_clock::time_point nextPoll {};
+
+			/// <summary>Returns the rest state of a gamepad (no buttons down, every axis at rest).</summary>
+			TinyVkGamepadChanges RestState() const {
+				TinyVkGamepadChanges rest {};
+				for (size_t a = 0; a < AxisCount; a++) rest.axes[a] = filters[a].rest;
+				return rest;
+			}
+
+			/// <summary>Applies the axis deadzone (snapping to rest) and rescales the remaining range.</summary>
+			float_t FilterAxis(size_t axis, float_t value) const {
+				const TinyVkGamepadAxisFilter& filter = filters[axis];
+				float_t offset = value - filter.rest;
+				float_t range = (filter.rest == 0.0f) ? 1.0f : 2.0f;
+				float_t magnitude = std::fabs(offset);
+
+				if (magnitude <= filter.deadzone) return filter.rest;
+				return filter.rest + std::copysign(std::min((magnitude - filter.deadzone) / (range - filter.deadzone), 1.0f) * range, offset);
+			}
+
+		public:
+			/// <summary>Invoked once per pad per poll with every button/axis change of that pad.</summary>
+			TinyVkEventQueue<TinyVkGamepads, TinyVkGamepadChanges> onGamepadChanged;
+
+			TinyVkGamepadPoller(const TinyVkGamepadPoller&) = delete;
+			TinyVkGamepadPoller& operator=(const TinyVkGamepadPoller&) = delete;
+
+			TinyVkGamepadPoller() {
+				filters[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER].rest = -1.0f;
+				filters[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER].rest = -1.0f;
+				cache.fill(RestState());
+			}
+
+			/// <summary>Sets the deadzone and hysteresis of an axis (for every gamepad).</summary>
+			void SetAxisFilter(TinyVkGamepadAxis axis, float_t deadzone, float_t hysteresis) {
+				TinyVkLockGuard g(poll_lock);
+				TinyVkGamepadAxisFilter& filter = filters[static_cast<int32_t>(axis)];
+				filter.deadzone = std::clamp(deadzone, 0.0f, 0.95f);
+				filter.hysteresis = std::max(hysteresis, 0.0f);
+			}
+
+			/// <summary>Caps how often Poll() reads the gamepads (0 polls on every call).</summary>
+			void SetPollRate(double_t pollsPerSecond) {
+				TinyVkLockGuard g(poll_lock);
+				pollInterval = (pollsPerSecond > 0.0) ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double_t>(1.0 / pollsPerSecond)) : std::chrono::steady_clock::duration::zero();
+			}
+
+			/// <summary>Marks a gamepad (dis)connected, disconnected pads report a return to rest on the next poll.</summary>
+			void SetConnected(TinyVkGamepads gpad, bool isConnected) {
+				int32_t pad = static_cast<int32_t>(gpad);
+				if (pad < 0 || pad >= static_cast<int32_t>(GamepadCount)) return;
+
+				if (isConnected && glfwJoystickIsGamepad(pad) == GLFW_TRUE) {
+					connected.fetch_or(1U << pad);
+					return;
+				}
+
+				connected.fetch_and(~(1U << pad));
+				TinyVkLockGuard g(poll_lock);
+
+				TinyVkGamepadChanges rest = RestState();
+				for (size_t a = 0; a < AxisCount; a++)
+					if (cache[pad].axes[a] != rest.axes[a]) rest.changedAxes |= 1U << a;
+
+				rest.changedButtons = cache[pad].buttons;
+				cache[pad] = RestState();
+				g.Unlock();
+
+				if (rest.changedAxes != 0 || rest.changedButtons != 0)
+					onGamepadChanged.post(gpad, rest);
+			}
+
+			/// <summary>Re-scans every joystick slot for connected gamepads (on startup, the joystick callback tracks them afterwards).</summary>
+			void Rescan() {
+				for (int32_t i = 0; i < static_cast<int32_t>(GamepadCount); i++)
+					SetConnected(static_cast<TinyVkGamepads>(i), glfwJoystickPresent(i) == GLFW_TRUE);
+			}
+
+			/// <summary>Returns the bitmask of connected gamepads.</summary>
+			uint32_t GetConnectedMask() const { return connected.load(); }
+
+			/// <summary>Polls the connected gamepads (unless rate limited) and posts their batched changes, returns the number of pads that changed.</summary>
+			size_t Poll() {
+				uint32_t pads = connected.load();
+				if (pads == 0) return 0;
+
+				TinyVkLockGuard g(poll_lock);
+				auto now = std::chrono::steady_clock::now();
+				if (now < nextPoll) return 0;
+				nextPoll = now + pollInterval;
+
+				std::array<TinyVkGamepadChanges, GamepadCount> changes;
+				uint32_t changed = 0;
+
+				for (; pads != 0; pads &= pads - 1) {
+					int32_t pad = std::countr_zero(pads);
+					GLFWgamepadstate gpstate;
+					if (glfwGetGamepadState(pad, &gpstate) == GLFW_FALSE) continue;
+
+					TinyVkGamepadChanges& state = cache[pad];
+					uint16_t buttons = 0;
+					for (int32_t b = 0; b <= GLFW_GAMEPAD_BUTTON_LAST; b++)
+						buttons |= static_cast<uint16_t>((gpstate.buttons[b] == GLFW_PRESS) ? 1U << b : 0U);
+
+					state.changedButtons = buttons ^ state.buttons;
+					state.buttons = buttons;
+					state.changedAxes = 0;
+
+					for (size_t a = 0; a < AxisCount; a++) {
+						float_t value = FilterAxis(a, gpstate.axes[a]);
+						if (value != state.axes[a] && (std::fabs(value - state.axes[a]) > filters[a].hysteresis || value == filters[a].rest)) {
+							state.axes[a] = value;
+							state.changedAxes |= 1U << a;
+						}
+					}
+
+					if (state.changedButtons != 0 || state.changedAxes != 0) {
+						changes[pad] = state;
+						changed |= 1U << pad;
+					}
+				}
+
+				g.Unlock();
+				for (uint32_t post = changed; post != 0; post &= post - 1) {
+					int32_t pad = std::countr_zero(post);
+					onGamepadChanged.post(static_cast<TinyVkGamepads>(pad), changes[pad]);
+				}
+
+				return std::popcount(changed);
+			}
+		};
+	}
+#endif
@@ -9,6 +9,8 @@
 
 		enum TinyVkDescriptorTypes {
 			TINYVK_DESCRIPTOR_IMAGE_SAMPLER = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+			TINYVK_DESCRIPTOR_SAMPLER = VK_DESCRIPTOR_TYPE_SAMPLER,
+			TINYVK_DESCRIPTOR_SAMPLED_IMAGE = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
 			TINYVK_DESCRIPTOR_STORAGE_IMAGE = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
 			TINYVK_DESCRIPTOR_UNIFORM_BUFFER = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
 			TINYVK_DESCRIPTOR_STORAGE_BUFFER = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
@@ -46,14 +48,18 @@
 			bool enableDepthTesting;
 			VkQueue graphicsQueue;
 			VkQueue presentQueue;
+			TinyVkAssetPack* shaderPack = nullptr;
 			
-			VkShaderModule CreateShaderModule(std::vector<char> shaderCode) {
+			VkShaderModule CreateShaderModule(const uint8_t* shaderCode, size_t codeSize) {
+				if (shaderCode == nullptr || codeSize == 0 || codeSize % sizeof(uint32_t) != 0)
+					throw std::runtime_error("TinyVulkan: Invalid SPIR-V shader code size!");
+
 				VkShaderModuleCreateInfo createInfo{};
 				createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
 				createInfo.pNext = nullptr;
 				createInfo.flags = 0;
-				createInfo.codeSize = shaderCode.size();
-				createInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
+				createInfo.codeSize = codeSize;
+				createInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode);
 
 				VkShaderModule shaderModule;
 				if (vkCreateShaderModule(vkdevice.logicalDevice, &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
@@ -76,20 +82,19 @@
 				return shaderStageInfo;
 			}
 
-			std::vector<char> ReadFile(const std::string& path) {
-				std::ifstream file(path, std::ios::ate | std::ios::binary);
+			void InitializePipeline(const std::vector<std::tuple<VkShaderStageFlagBits, std::string>>& shaders, bool enableDepthTesting) {
+				this->enableBlending = colorBlendState.blendEnable;
+				this->enableDepthTesting = enableDepthTesting;
 
-				if (!file.is_open())
-					throw std::runtime_error("TinyVulkan: Failed to Read File: " + path);
+				TinyVkQueueFamily indices = vkdevice.FindQueueFamilies();
+				vkGetDeviceQueue(vkdevice.logicalDevice, indices.graphicsFamily.value(), 0, &graphicsQueue);
+				
+				if (vkdevice.presentSurface != nullptr)
+					vkGetDeviceQueue(vkdevice.logicalDevice, indices.presentFamily.value(), 0, &presentQueue);
 
-				size_t fsize = static_cast<size_t>(file.tellg());
-				std::vector<char> buffer(fsize);
-				file.seekg(0);
-				file.read(buffer.data(), fsize);
-				file.close();
-				return buffer;
+				CreateGraphicsPipeline(shaders);
 			}
-			
+
 			void CreateGraphicsPipeline(const std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders) {
 				///////////////////////////////////////////////////////////////////////////////////////////////////////
 				/////////// This section specifies that TinyVkVertex provides the vertex layout description ///////////
@@ -202,8 +207,16 @@
 				///////////////////////////////////////////////////////////////////////////////////////////////////////
 				std::vector<VkPipelineShaderStageCreateInfo> shaderCreateInfo;
 				for (size_t i = 0; i < shaders.size(); i++) {
-					auto shaderCode = ReadFile(std::get<1>(shaders[i]));
-					auto shaderModule = CreateShaderModule(shaderCode);
+					// SPIR-V is read straight from the (page/16-byte aligned) file or pack mapping, the module copies it on creation.
+					VkShaderModule shaderModule;
+					if (shaderPack != nullptr) {
+						std::vector<uint8_t> scratch;
+						const TinyVkAssetEntry& entry = shaderPack->GetEntry(std::get<1>(shaders[i]));
+						shaderModule = CreateShaderModule(shaderPack->MapEntry(entry, scratch), static_cast<size_t>(entry.size));
+					} else {
+						TinyVkMappedFile shaderFile(std::get<1>(shaders[i]));
+						shaderModule = CreateShaderModule(shaderFile.GetData(), shaderFile.GetSize());
+					}
 					shaderModules.push_back(shaderModule);
 					shaderCreateInfo.push_back(CreateShaderInfo(std::get<1>(shaders[i]), shaderModule, std::get<0>(shaders[i])));
 				}
@@ -241,30 +254,41 @@
 			~TinyVkGraphicsPipeline() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
-				if (waitIdle) vkDeviceWaitIdle(vkdevice.logicalDevice);
-
-				vkDestroyDescriptorSetLayout(vkdevice.logicalDevice, descriptorLayout, nullptr);
-				vkDestroyPipeline(vkdevice.logicalDevice, graphicsPipeline, nullptr);
-				vkDestroyPipelineLayout(vkdevice.logicalDevice, pipelineLayout, nullptr);
-
-				for(auto shaderModule : shaderModules)
-					vkDestroyShaderModule(vkdevice.logicalDevice, shaderModule, nullptr);
+				VkDevice logicalDevice = vkdevice.logicalDevice;
+				VkDescriptorSetLayout descriptorLayout = this->descriptorLayout;
+				VkPipeline graphicsPipeline = this->graphicsPipeline;
+				VkPipelineLayout pipelineLayout = this->pipelineLayout;
+				std::vector<VkShaderModule> shaderModules = this->shaderModules;
+
+				auto destructor = [logicalDevice, descriptorLayout, graphicsPipeline, pipelineLayout, shaderModules]() {
+					vkDestroyDescriptorSetLayout(logicalDevice, descriptorLayout, nullptr);
+					vkDestroyPipeline(logicalDevice, graphicsPipeline, nullptr);
+					vkDestroyPipelineLayout(logicalDevice, pipelineLayout, nullptr);
+
+					for(auto shaderModule : shaderModules)
+						vkDestroyShaderModule(logicalDevice, shaderModule, nullptr);
+				};
+
+				if (waitIdle) {
+					vkdevice.deletionQueue.Enqueue(destructor);
+				} else destructor();
 			}
 
 			TinyVkGraphicsPipeline(TinyVkVulkanDevice& vkdevice, VkFormat imageFormat, TinyVkVertexDescription vertexDescription, const std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders, const std::vector<VkDescriptorSetLayoutBinding>& descriptorBindings, const std::vector<VkPushConstantRange>& pushConstantRanges, bool enableDepthTesting, VkPipelineColorBlendAttachmentState colorBlendState = GetBlendDescription(true), VkColorComponentFlags colorComponentFlags = VKCOMP_RGBA, VkPrimitiveTopology vertexTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VkPolygonMode polgyonTopology = VK_POLYGON_MODE_FILL)
 			: vkdevice(vkdevice), imageFormat(imageFormat), vertexDescription(vertexDescription), descriptorBindings(descriptorBindings), pushConstantRanges(pushConstantRanges), colorComponentFlags(colorComponentFlags), colorBlendState(colorBlendState), vertexTopology(vertexTopology), polgyonTopology(polgyonTopology) {
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+				InitializePipeline(shaders, enableDepthTesting);
 
-				this->enableBlending = colorBlendState.blendEnable;
-				this->enableDepthTesting = enableDepthTesting;
+				SetOwner(vkdevice);
+			}
 
-				TinyVkQueueFamily indices = vkdevice.FindQueueFamilies();
-				vkGetDeviceQueue(vkdevice.logicalDevice, indices.graphicsFamily.value(), 0, &graphicsQueue);
-				
-				if (vkdevice.presentSurface != nullptr)
-					vkGetDeviceQueue(vkdevice.logicalDevice, indices.presentFamily.value(), 0, &presentQueue);
+			/// <summary>Creates a graphics pipeline whose shaders are asset names in the (memory-mapped) asset pack instead of file paths.</summary>
+			TinyVkGraphicsPipeline(TinyVkVulkanDevice& vkdevice, VkFormat imageFormat, TinyVkVertexDescription vertexDescription, TinyVkAssetPack& shaderPack, const std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders, const std::vector<VkDescriptorSetLayoutBinding>& descriptorBindings, const std::vector<VkPushConstantRange>& pushConstantRanges, bool enableDepthTesting, VkPipelineColorBlendAttachmentState colorBlendState = GetBlendDescription(true), VkColorComponentFlags colorComponentFlags = VKCOMP_RGBA, VkPrimitiveTopology vertexTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VkPolygonMode polgyonTopology = VK_POLYGON_MODE_FILL)
+			: vkdevice(vkdevice), imageFormat(imageFormat), vertexDescription(vertexDescription), shaderPack(&shaderPack), descriptorBindings(descriptorBindings), pushConstantRanges(pushConstantRanges), colorComponentFlags(colorComponentFlags), colorBlendState(colorBlendState), vertexTopology(vertexTopology), polgyonTopology(polgyonTopology) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+				InitializePipeline(shaders, enableDepthTesting);
 
-				CreateGraphicsPipeline(shaders);
+				SetOwner(vkdevice);
 			}
 
 			#pragma region REFERENCE_GETTERS
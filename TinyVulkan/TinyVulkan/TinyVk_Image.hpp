@@ -23,6 +23,23 @@
 					To render to shaders you must change/transition the layout to VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL.
 					Once the layout is set for transfering you can write data to the image from CPU memory to GPU memory.
 					Finally for use in shaders you need to change the layout to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+
+				Uploads (Stage*Data()) write a temporary mapped staging buffer unless SetStagingBuffer() shares a reusable
+				TinyVkStagingBuffer (grown on demand) between the uploads of many images, e.g. while loading a level.
+
+				Mipmapped images are created with mipLevels > 1 (GetMaxMipLevels(width, height) for a full chain):
+					StageImageData() uploads mip level 0 and generates the remaining levels on the GPU with vkCmdBlitImage,
+					all recorded into the same command buffer as the upload. StageMipLevelsData() uploads pre-baked levels
+					(tightly packed level 0, 1, 2...) and generates any levels that were not provided.
+					Every mip level shares the image's currentLayout, layout transitions always cover the whole mip chain.
+
+				Array images are created with arrayLayers > 1 (VK_IMAGE_VIEW_TYPE_2D_ARRAY view, sampler2DArray in shaders):
+					Staged data holds every layer of a mip level tightly packed (level 0 layer 0, 1, 2... then level 1...).
+
+				Block-compressed images (BC1-7, ETC2/EAC, ASTC) are created like any other image with a compressed format
+				(check support with vkdevice.QueryFormatSupport() or pick one with vkdevice.QueryCompressedFormat()):
+					Staged data is tightly packed texel blocks, byte sizes round the (mip) extent up to whole blocks.
+					Compressed images cannot be rendered to or blitted: stage every mip level pre-baked (see TinyVkBlockEncoder).
 		*/
 
 		enum TinyVkImageLayout {
@@ -42,12 +59,13 @@
 			TinyVkCommandPool& commandPool;
 			
 			VkSamplerAddressMode addressingMode;
+			TinyVkStagingBuffer* stagingBuffer = nullptr;
 
 			void CreateImageView() {
 				VkImageViewCreateInfo createInfo{};
 				createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
 				createInfo.image = image;
-				createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+				createInfo.viewType = (arrayLayers > 1) ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
 				createInfo.format = format;
 				
 				createInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
@@ -57,39 +75,16 @@
 
 				createInfo.subresourceRange.aspectMask = aspectFlags;
 				createInfo.subresourceRange.baseMipLevel = 0;
-				createInfo.subresourceRange.levelCount = 1;
+				createInfo.subresourceRange.levelCount = mipLevels;
 				createInfo.subresourceRange.baseArrayLayer = 0;
-				createInfo.subresourceRange.layerCount = 1;
+				createInfo.subresourceRange.layerCount = arrayLayers;
 
 				if (vkCreateImageView(vkdevice.logicalDevice, &createInfo, nullptr, &imageView) != VK_SUCCESS)
 					throw std::runtime_error("TinyVulkan: Failed to create TinyVkImage view!");
 			}
 
 			void CreateTextureSampler() {
-				VkSamplerCreateInfo samplerInfo {};
-				samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-				samplerInfo.magFilter = VK_FILTER_LINEAR;
-				samplerInfo.minFilter = VK_FILTER_LINEAR;
-				samplerInfo.addressModeU = addressingMode;
-				samplerInfo.addressModeV = addressingMode;
-				samplerInfo.addressModeW = addressingMode;
-				samplerInfo.anisotropyEnable = VK_FALSE;
-				
-				VkPhysicalDeviceProperties properties{};
-				vkGetPhysicalDeviceProperties(vkdevice.physicalDevice, &properties);
-				samplerInfo.maxAnisotropy = properties.limits.maxSamplerAnisotropy;
-
-				samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-				samplerInfo.unnormalizedCoordinates = VK_FALSE;
-				samplerInfo.compareEnable = VK_FALSE;
-				samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
-				samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-				samplerInfo.mipLodBias = 0.0f;
-				samplerInfo.minLod = 0.0f;
-				samplerInfo.maxLod = 0.0f;
-
-				if (vkCreateSampler(vkdevice.logicalDevice, &samplerInfo, nullptr, &imageSampler) != VK_SUCCESS)
-					throw std::runtime_error("TinyVulkan: Failed to create image texture sampler!");
+				imageSampler = vkdevice.samplerCache.Acquire(TinyVkSamplerCache::CreateInfo(addressingMode));
 			}
 
 			void CreateImageSyncObjects() {
@@ -106,8 +101,20 @@
 					throw std::runtime_error("TinyVulkan: Failed to create synchronization objects for a image renderer!");
 			}
 			
+			/// <summary>Writes and copies the staged mip levels through the mapped staging buffer (see StageImageDataWith()).</summary>
+			void StageImageDataFrom(TinyVkBuffer& staging, VkDeviceSize dataSize, const std::function<void(void* mappedData)>& writeStaging, uint32_t levelCount) {
+				writeStaging(staging.description.pMappedData);
+				vmaFlushAllocation(vkdevice.GetAllocator(), staging.memory, 0, dataSize);
+
+				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = BeginTransferCmd();
+				TransitionLayoutCmd(bufferIndexPair.first, TINYVK_TRANSFER_DST_OPTIMAL);
+				TransferMipLevelsFromBufferCmd(bufferIndexPair.first, staging, levelCount);
+				GenerateMipmapsCmd(bufferIndexPair.first, levelCount - 1);
+				EndTransferCmd(bufferIndexPair);
+			}
+
 		public:
-			std::timed_mutex image_lock;
+			TinyVkSpinMutex image_lock;
 
 			VmaAllocation memory = VK_NULL_HANDLE;
 			VkImage image = VK_NULL_HANDLE;
@@ -122,41 +129,68 @@
 
 			VkDeviceSize width, height;
 			VkFormat format;
+			uint32_t mipLevels = 1;
+			uint32_t arrayLayers = 1;
 			bool isDepthImage = false;
 
 			~TinyVkImage() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
-				if (waitIdle) vkdevice.DeviceWaitIdle();
-
-				vkDestroySampler(vkdevice.logicalDevice, imageSampler, nullptr);
-				vkDestroyImageView(vkdevice.logicalDevice, imageView, nullptr);
-				vmaDestroyImage(vkdevice.GetAllocator(), image, memory);
-
-				vkDestroySemaphore(vkdevice.logicalDevice, imageAvailable, nullptr);
-				vkDestroySemaphore(vkdevice.logicalDevice, imageFinished, nullptr);
-				vkDestroyFence(vkdevice.logicalDevice, imageWaitable, nullptr);
+				TinyVkDeletionQueue& deletionQueue = vkdevice.deletionQueue;
+				TinyVkSamplerCache& samplerCache = vkdevice.samplerCache;
+				VkDevice logicalDevice = vkdevice.logicalDevice;
+				VmaAllocator allocator = vkdevice.GetAllocator();
+				VkSampler imageSampler = this->imageSampler;
+				VkImageView imageView = this->imageView;
+				VkImage image = this->image;
+				VmaAllocation memory = this->memory;
+				VkSemaphore imageAvailable = this->imageAvailable;
+				VkSemaphore imageFinished = this->imageFinished;
+				VkFence imageWaitable = this->imageWaitable;
+
+				auto destructor = [&deletionQueue, &samplerCache, logicalDevice, allocator, imageSampler, imageView, image, memory, imageAvailable, imageFinished, imageWaitable]() {
+					samplerCache.Release(imageSampler);
+					vkDestroyImageView(logicalDevice, imageView, nullptr);
+					vmaDestroyImage(allocator, image, memory);
+
+					deletionQueue.RetireFence(imageWaitable);
+					vkDestroySemaphore(logicalDevice, imageAvailable, nullptr);
+					vkDestroySemaphore(logicalDevice, imageFinished, nullptr);
+					vkDestroyFence(logicalDevice, imageWaitable, nullptr);
+				};
+
+				if (waitIdle) {
+					deletionQueue.Enqueue(destructor);
+				} else destructor();
 			}
 
 			/// <summary>Creates a VkImage for rendering or loading image files (stagedata) into.</summary>
-			TinyVkImage(TinyVkVulkanDevice& vkdevice, TinyVkGraphicsPipeline& graphicsPipeline, TinyVkCommandPool& commandPool, VkDeviceSize width, VkDeviceSize height, bool isDepthImage = false, VkFormat format = VK_FORMAT_B8G8R8A8_SRGB, TinyVkImageLayout layout = TINYVK_UNDEFINED, VkSamplerAddressMode addressingMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT)
-			: vkdevice(vkdevice), graphicsPipeline(graphicsPipeline), commandPool(commandPool), width(width), height(height), isDepthImage(isDepthImage), format(format), currentLayout(TINYVK_UNDEFINED), addressingMode(addressingMode), aspectFlags(aspectFlags) {
+			TinyVkImage(TinyVkVulkanDevice& vkdevice, TinyVkGraphicsPipeline& graphicsPipeline, TinyVkCommandPool& commandPool, VkDeviceSize width, VkDeviceSize height, bool isDepthImage = false, VkFormat format = VK_FORMAT_B8G8R8A8_SRGB, TinyVkImageLayout layout = TINYVK_UNDEFINED, VkSamplerAddressMode addressingMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT, uint32_t mipLevels = 1, uint32_t arrayLayers = 1)
+			: vkdevice(vkdevice), graphicsPipeline(graphicsPipeline), commandPool(commandPool), width(width), height(height), isDepthImage(isDepthImage), format(format), currentLayout(TINYVK_UNDEFINED), addressingMode(addressingMode), aspectFlags(aspectFlags), mipLevels(mipLevels), arrayLayers(arrayLayers) {
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
 
-				ReCreateImage(width, height, isDepthImage, format, layout, addressingMode, aspectFlags);
+				ReCreateImage(width, height, isDepthImage, format, layout, addressingMode, aspectFlags, mipLevels, arrayLayers);
+
+				SetOwner(vkdevice);
 			}
 
 			TinyVkImage operator=(const TinyVkImage& image) = delete;
 
 			/// <summary>Recreates this TinyVkImage using a new layout/format (don't forget to call image.Disposable(bool waitIdle) to dispose of the previous image first.</summary>
-			void ReCreateImage(VkDeviceSize width, VkDeviceSize height, bool isDepthImage = false, VkFormat format = VK_FORMAT_B8G8R8A8_SRGB, TinyVkImageLayout layout = TINYVK_UNDEFINED, VkSamplerAddressMode addressingMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT) {
+			void ReCreateImage(VkDeviceSize width, VkDeviceSize height, bool isDepthImage = false, VkFormat format = VK_FORMAT_B8G8R8A8_SRGB, TinyVkImageLayout layout = TINYVK_UNDEFINED, VkSamplerAddressMode addressingMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT, uint32_t mipLevels = 1, uint32_t arrayLayers = 1) {
+				if (mipLevels == 0 || mipLevels > GetMaxMipLevels(width, height))
+					throw std::runtime_error("TinyVulkan: TinyVkImage mip level count is out of range for its width/height!");
+
+				if (arrayLayers == 0)
+					throw std::runtime_error("TinyVulkan: TinyVkImage requires at least 1 array layer!");
+
 				VkImageCreateInfo imgCreateInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
 				imgCreateInfo.imageType = VK_IMAGE_TYPE_2D;
 				imgCreateInfo.extent.width = static_cast<uint32_t>(width);
 				imgCreateInfo.extent.height = static_cast<uint32_t>(height);
 				imgCreateInfo.extent.depth = 1;
-				imgCreateInfo.mipLevels = 1;
-				imgCreateInfo.arrayLayers = 1;
+				imgCreateInfo.mipLevels = mipLevels;
+				imgCreateInfo.arrayLayers = arrayLayers;
 				imgCreateInfo.format = format;
 				imgCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
 				imgCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -164,9 +198,12 @@
 				currentLayout = TINYVK_UNDEFINED;
 				this->width = width;
 				this->height = height;
+				this->mipLevels = mipLevels;
+				this->arrayLayers = arrayLayers;
 
 				if (!isDepthImage) {
 					imgCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+					if (IsCompressedFormat(format)) imgCreateInfo.usage &= ~VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 				} else {
 					imgCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
 					layout = TINYVK_DEPTHSTENCIL_ATTACHMENT_OPTIMAL;
@@ -191,7 +228,12 @@
 			/// <summary>Transitions the GPU bound VkImage from its current layout into a new layout.</summary>
 			void TransitionLayoutCmd(TinyVkImageLayout newLayout) {
 				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = BeginTransferCmd();
+				TransitionLayoutCmd(bufferIndexPair.first, newLayout);
+				EndTransferCmd(bufferIndexPair);
+			}
 
+			/// <summary>Records a layout transition from the current layout into a new layout to a command buffer in the recording state (does not submit).</summary>
+			void TransitionLayoutCmd(VkCommandBuffer commandBuffer, TinyVkImageLayout newLayout) {
 				VkImageMemoryBarrier barrier{};
 				barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 				barrier.oldLayout = (VkImageLayout) currentLayout;
@@ -201,9 +243,9 @@
 				barrier.image = image;
 				barrier.subresourceRange.aspectMask = aspectFlags;
 				barrier.subresourceRange.baseMipLevel = 0;
-				barrier.subresourceRange.levelCount = 1;
+				barrier.subresourceRange.levelCount = mipLevels;
 				barrier.subresourceRange.baseArrayLayer = 0;
-				barrier.subresourceRange.layerCount = 1;
+				barrier.subresourceRange.layerCount = arrayLayers;
 
 				VkPipelineStageFlags sourceStage;
 				VkPipelineStageFlags destinationStage;
@@ -225,6 +267,10 @@
 						barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 						sourceStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
 					break;
+					case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+						barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+						sourceStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+					break;
 					case VK_IMAGE_LAYOUT_UNDEFINED:
 					default:
 						barrier.srcAccessMask = VK_ACCESS_NONE;
@@ -261,27 +307,104 @@
 				}
 
 				currentLayout = newLayout;
-				vkCmdPipelineBarrier(bufferIndexPair.first, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+				vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+			}
 
-				EndTransferCmd(bufferIndexPair);
+			/// <summary>Lets writeStaging fill (decode/decompress into) a mapped staging buffer of dataSize bytes with levelCount tightly packed mip levels and copies it to the GPU (generating the remaining mip levels).</summary>
+			void StageImageDataWith(VkDeviceSize dataSize, const std::function<void(void* mappedData)>& writeStaging, uint32_t levelCount = 1) {
+				if (levelCount == 0 || levelCount > mipLevels)
+					throw std::runtime_error("TinyVulkan: Staged mip level count is out of range for the TinyVkImage!");
+
+				if (stagingBuffer != nullptr) {
+					TinyVkLockGuard g(stagingBuffer->staging_lock);
+					StageImageDataFrom(stagingBuffer->Reserve(dataSize), dataSize, writeStaging, levelCount);
+					return;
+				}
+
+				TinyVkBuffer temporaryBuffer = TinyVkBuffer(vkdevice, graphicsPipeline, commandPool, dataSize, TinyVkBufferType::VKVMA_BUFFER_TYPE_STAGING);
+				StageImageDataFrom(temporaryBuffer, dataSize, writeStaging, levelCount);
+				temporaryBuffer.Dispose(false); // EndTransferCmd() has already waited on the transfer.
 			}
 
+			/// <summary>Stages uploads through a shared, reusable staging buffer instead of a temporary one per upload (nullptr: temporary buffers), it must outlive the uploads of this image.</summary>
+			void SetStagingBuffer(TinyVkStagingBuffer* stagingBuffer) { this->stagingBuffer = stagingBuffer; }
+
 			/// <summary>Copies data from CPU accessible memory to GPU accessible memory.</summary>
 			void StageImageData(void* data, VkDeviceSize dataSize) {
-				TinyVkBuffer stagingBuffer = TinyVkBuffer(vkdevice, graphicsPipeline, commandPool, dataSize, TinyVkBufferType::VKVMA_BUFFER_TYPE_STAGING);
-				memcpy(stagingBuffer.description.pMappedData, data, (size_t)dataSize);
+				StageImageDataWith(dataSize, [data, dataSize](void* mappedData) { memcpy(mappedData, data, (size_t)dataSize); });
+			}
+
+			/// <summary>Copies levelCount pre-baked, tightly packed mip levels (level 0, 1, 2...) to the GPU and generates any remaining mip levels.</summary>
+			void StageMipLevelsData(const void* data, VkDeviceSize dataSize, uint32_t levelCount) {
+				if (dataSize != GetMipChainByteSize(levelCount))
+					throw std::runtime_error("TinyVulkan: Staged mip level data does not match the TinyVkImage mip level sizes!");
+
+				StageImageDataWith(dataSize, [data, dataSize](void* mappedData) { memcpy(mappedData, data, (size_t)dataSize); }, levelCount);
+			}
+
+			/// <summary>Decodes a plain or tiled QOI image (matching this image's width/height) directly into mapped staging memory and copies it to the GPU. BGRA formats are swizzled during decoding, BC7/ETC2 RGBA formats are transcoded with every mip level.</summary>
+			void StageQoiImageData(const void* data, size_t dataSize, size_t threadCount = 1) {
+				bool swizzleBGR = false;
+				bool transcode = TinyVkBlockEncoder::IsEncodableFormat(format);
+				if ((!transcode && !GetQoiFormatSwizzle(format, swizzleBGR)) || arrayLayers != 1)
+					throw std::runtime_error("TinyVulkan: QOI images can only be staged into 8-bit RGBA/BGRA or BC7/ETC2 RGBA single layer TinyVkImages!");
+
+				qoi_desc desc;
+				if (!TinyVkTiledQoi::ReadHeader(data, dataSize, desc) || desc.width != width || desc.height != height)
+					throw std::runtime_error("TinyVulkan: QOI image is invalid or does not match the TinyVkImage width/height!");
+
+				if (transcode) {
+					// Runtime transcoding: prefer packing pre-encoded PIXELS assets (AssetPacker --bc7/--etc2) for large images.
+					std::vector<uint8_t> pixels(static_cast<size_t>(width * height * 4));
+					TinyVkTiledQoi::DecodeInto(data, dataSize, desc, pixels.data(), pixels.size(), 4, false, threadCount);
+					std::vector<uint8_t> blocks = TinyVkBlockEncoder::EncodeMipChain(format, pixels.data(), desc.width, desc.height, mipLevels, threadCount);
+					StageMipLevelsData(blocks.data(), blocks.size(), mipLevels);
+					return;
+				}
+
+				VkDeviceSize imageSize = GetImageByteSize();
+				StageImageDataWith(imageSize, [&](void* mappedData) {
+					TinyVkTiledQoi::DecodeInto(data, dataSize, desc, mappedData, static_cast<size_t>(imageSize), 4, swizzleBGR, threadCount);
+				});
+			}
+
+			/// <summary>Memory-maps a plain or tiled QOI image file and decodes it directly into mapped staging memory (see StageQoiImageData).</summary>
+			void StageQoiImageFile(const std::string& path, size_t threadCount = 1) {
+				TinyVkMappedFile file(path);
+				StageQoiImageData(file.GetData(), file.GetSize(), threadCount);
+			}
+
+			/// <summary>Stages a QOI or raw pixel asset from an asset pack: raw pixels are copied/decompressed straight into mapped staging memory.</summary>
+			void StageAssetImageData(TinyVkAssetPack& assetPack, const std::string& name, size_t threadCount = 1) {
+				const TinyVkAssetEntry& entry = assetPack.GetEntry(name);
+
+				if (entry.type == TinyVkAssetType::TINYVK_ASSET_QOI) {
+					std::vector<uint8_t> scratch;
+					const uint8_t* data = assetPack.MapEntry(entry, scratch);
+					StageQoiImageData(data, static_cast<size_t>(entry.size), threadCount);
+				} else if (entry.type == TinyVkAssetType::TINYVK_ASSET_PIXELS) {
+					uint32_t levelCount = 1;
+					while (levelCount < mipLevels && entry.size > GetMipChainByteSize(levelCount)) levelCount++;
 
-				TransitionLayoutCmd(TINYVK_TRANSFER_DST_OPTIMAL);
-				TransferFromBufferCmd(stagingBuffer);
-				TransitionLayoutCmd(TINYVK_SHADER_READONLY_OPTIMAL);
+					if (entry.width != width || entry.height != height || static_cast<VkFormat>(entry.format) != format || entry.size != GetMipChainByteSize(levelCount))
+						throw std::runtime_error("TinyVulkan: Asset pixels do not match the TinyVkImage width/height/format/mip levels: " + name);
 
-				stagingBuffer.Dispose();
+					StageImageDataWith(entry.size, [&](void* mappedData) { assetPack.ReadInto(entry, mappedData, static_cast<size_t>(entry.size)); }, levelCount);
+				} else {
+					throw std::runtime_error("TinyVulkan: Asset is not an image: " + name);
+				}
 			}
 
 			/// <summary>Copies data from the source TinyVkBuffer into this TinyVkImage.</summary>
 			void TransferFromBufferCmd(TinyVkBuffer& srcBuffer) {
 				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = BeginTransferCmd();
+				TransferFromBufferCmd(bufferIndexPair.first, srcBuffer);
+				EndTransferCmd(bufferIndexPair);
+			}
 
+			/// <summary>Records a copy from the source TinyVkBuffer into this TinyVkImage (in TRANSFER_DST layout) to a command buffer in the recording state (does not submit).</summary>
+			void TransferFromBufferCmd(VkCommandBuffer commandBuffer, TinyVkBuffer& srcBuffer) {
+				// Row length/image height 0 means tightly packed: whole texel blocks rounded up from the (mip) extent for compressed formats.
 				VkBufferImageCopy region{};
 				region.bufferOffset = 0;
 				region.bufferRowLength = 0;
@@ -289,11 +412,104 @@
 				region.imageSubresource.aspectMask = aspectFlags;
 				region.imageSubresource.mipLevel = 0;
 				region.imageSubresource.baseArrayLayer = 0;
-				region.imageSubresource.layerCount = 1;
+				region.imageSubresource.layerCount = arrayLayers;
 				region.imageOffset = { 0, 0, 0 };
 				region.imageExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 };
-				vkCmdCopyBufferToImage(bufferIndexPair.first, srcBuffer.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+				vkCmdCopyBufferToImage(commandBuffer, srcBuffer.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+			}
 
+			/// <summary>Records copies of levelCount tightly packed mip levels from the source TinyVkBuffer into this TinyVkImage (in TRANSFER_DST layout) to a command buffer in the recording state (does not submit).</summary>
+			void TransferMipLevelsFromBufferCmd(VkCommandBuffer commandBuffer, TinyVkBuffer& srcBuffer, uint32_t levelCount) {
+				std::vector<VkBufferImageCopy> regions(levelCount);
+				VkDeviceSize bufferOffset = 0;
+
+				for (uint32_t level = 0; level < levelCount; level++) {
+					VkBufferImageCopy& region = regions[level];
+					region.bufferOffset = bufferOffset;
+					region.bufferRowLength = 0;
+					region.bufferImageHeight = 0;
+					region.imageSubresource.aspectMask = aspectFlags;
+					region.imageSubresource.mipLevel = level;
+					region.imageSubresource.baseArrayLayer = 0;
+					region.imageSubresource.layerCount = arrayLayers;
+					region.imageOffset = { 0, 0, 0 };
+					region.imageExtent = { GetMipExtent(width, level), GetMipExtent(height, level), 1 };
+					bufferOffset += GetMipByteSize(level);
+				}
+
+				vkCmdCopyBufferToImage(commandBuffer, srcBuffer.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, levelCount, regions.data());
+			}
+
+			/// <summary>Records the GPU mip chain generation (vkCmdBlitImage) from mip level baseLevel (all levels in TRANSFER_DST layout, levels 0 to baseLevel filled) and transitions the image to SHADER_READONLY_OPTIMAL (does not submit).</summary>
+			void GenerateMipmapsCmd(VkCommandBuffer commandBuffer, uint32_t baseLevel = 0) {
+				if (currentLayout != TINYVK_TRANSFER_DST_OPTIMAL)
+					throw std::runtime_error("TinyVulkan: TinyVkImage must be in the TRANSFER_DST layout to generate mipmaps!");
+
+				VkFilter filter = VK_FILTER_LINEAR;
+				if (baseLevel + 1 < mipLevels) {
+					VkFormatProperties properties;
+					vkGetPhysicalDeviceFormatProperties(vkdevice.physicalDevice, format, &properties);
+
+					VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+					if ((properties.optimalTilingFeatures & blitFeatures) != blitFeatures)
+						throw std::runtime_error("TinyVulkan: TinyVkImage format does not support blitting for mipmap generation (compressed formats require pre-baked mip levels)!");
+
+					if (!(properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+						filter = VK_FILTER_NEAREST;
+				}
+
+				VkImageMemoryBarrier barrier{};
+				barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.image = image;
+				barrier.subresourceRange = { aspectFlags, 0, baseLevel, 0, arrayLayers };
+				barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+				if (baseLevel > 0)
+					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+				for (uint32_t level = baseLevel + 1; level < mipLevels; level++) {
+					barrier.subresourceRange.baseMipLevel = level - 1;
+					barrier.subresourceRange.levelCount = 1;
+					barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+					barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+					barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+					barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+					VkImageBlit blit{};
+					blit.srcSubresource = { aspectFlags, level - 1, 0, arrayLayers };
+					blit.srcOffsets[1] = { static_cast<int32_t>(GetMipExtent(width, level - 1)), static_cast<int32_t>(GetMipExtent(height, level - 1)), 1 };
+					blit.dstSubresource = { aspectFlags, level, 0, arrayLayers };
+					blit.dstOffsets[1] = { static_cast<int32_t>(GetMipExtent(width, level)), static_cast<int32_t>(GetMipExtent(height, level)), 1 };
+					vkCmdBlitImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, filter);
+
+					barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+					barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+					barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+					barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+				}
+
+				barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+				barrier.subresourceRange.levelCount = 1;
+				barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+				currentLayout = TINYVK_SHADER_READONLY_OPTIMAL;
+			}
+
+			/// <summary>Generates the mip chain from mip level 0 on the GPU (e.g. after rendering into the image) and transitions the image to SHADER_READONLY_OPTIMAL.</summary>
+			void GenerateMipmaps() {
+				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = BeginTransferCmd();
+				TransitionLayoutCmd(bufferIndexPair.first, TINYVK_TRANSFER_DST_OPTIMAL);
+				GenerateMipmapsCmd(bufferIndexPair.first);
 				EndTransferCmd(bufferIndexPair);
 			}
 
@@ -340,9 +556,144 @@
 				commandPool.ReturnBuffer(bufferIndexPair);
 			}
 
+			/// <summary>Returns true if QOI images can be decoded into the format (8-bit RGBA/BGRA) and whether decoding must swizzle to BGRA.</summary>
+			static bool GetQoiFormatSwizzle(VkFormat format, bool& swizzleBGR) {
+				switch (format) {
+					case VK_FORMAT_R8G8B8A8_UNORM: case VK_FORMAT_R8G8B8A8_SRGB:
+						swizzleBGR = false;
+					return true;
+					case VK_FORMAT_B8G8R8A8_UNORM: case VK_FORMAT_B8G8R8A8_SRGB:
+						swizzleBGR = true;
+					return true;
+					default:
+					return false;
+				}
+			}
+
+			/// <summary>Returns the size in bytes of a single texel of an uncompressed format (0 if the format is unknown/unsupported).</summary>
+			static VkDeviceSize GetFormatTexelSize(VkFormat format) {
+				switch (format) {
+					case VK_FORMAT_R8_UNORM: case VK_FORMAT_R8_SNORM: case VK_FORMAT_R8_UINT: case VK_FORMAT_R8_SINT: case VK_FORMAT_R8_SRGB: case VK_FORMAT_S8_UINT:
+						return 1;
+					case VK_FORMAT_R8G8_UNORM: case VK_FORMAT_R8G8_SNORM: case VK_FORMAT_R8G8_UINT: case VK_FORMAT_R8G8_SINT: case VK_FORMAT_R8G8_SRGB:
+					case VK_FORMAT_R16_UNORM: case VK_FORMAT_R16_SFLOAT: case VK_FORMAT_R16_UINT: case VK_FORMAT_R16_SINT: case VK_FORMAT_D16_UNORM:
+						return 2;
+					case VK_FORMAT_R8G8B8A8_UNORM: case VK_FORMAT_R8G8B8A8_SNORM: case VK_FORMAT_R8G8B8A8_UINT: case VK_FORMAT_R8G8B8A8_SINT: case VK_FORMAT_R8G8B8A8_SRGB:
+					case VK_FORMAT_B8G8R8A8_UNORM: case VK_FORMAT_B8G8R8A8_SNORM: case VK_FORMAT_B8G8R8A8_UINT: case VK_FORMAT_B8G8R8A8_SINT: case VK_FORMAT_B8G8R8A8_SRGB:
+					case VK_FORMAT_A2B10G10R10_UNORM_PACK32: case VK_FORMAT_A2R10G10B10_UNORM_PACK32: case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+					case VK_FORMAT_R16G16_UNORM: case VK_FORMAT_R16G16_SFLOAT: case VK_FORMAT_R32_SFLOAT: case VK_FORMAT_R32_UINT: case VK_FORMAT_R32_SINT:
+					case VK_FORMAT_D32_SFLOAT: case VK_FORMAT_D24_UNORM_S8_UINT: case VK_FORMAT_X8_D24_UNORM_PACK32:
+						return 4;
+					case VK_FORMAT_R16G16B16A16_UNORM: case VK_FORMAT_R16G16B16A16_SFLOAT: case VK_FORMAT_R16G16B16A16_UINT: case VK_FORMAT_R16G16B16A16_SINT:
+					case VK_FORMAT_R32G32_SFLOAT: case VK_FORMAT_R32G32_UINT: case VK_FORMAT_R32G32_SINT:
+						return 8;
+					case VK_FORMAT_R32G32B32A32_SFLOAT: case VK_FORMAT_R32G32B32A32_UINT: case VK_FORMAT_R32G32B32A32_SINT:
+						return 16;
+					default:
+						return 0;
+				}
+			}
+
+			/// <summary>Returns the texel block width/height and block size in bytes of a format (1x1 texel blocks for uncompressed formats, false if the format is unknown/unsupported).</summary>
+			static bool GetFormatBlockExtent(VkFormat format, uint32_t& blockWidth, uint32_t& blockHeight, VkDeviceSize& blockSize) {
+				blockWidth = blockHeight = 4;
+				switch (format) {
+					case VK_FORMAT_BC1_RGB_UNORM_BLOCK: case VK_FORMAT_BC1_RGB_SRGB_BLOCK: case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+					case VK_FORMAT_BC4_UNORM_BLOCK: case VK_FORMAT_BC4_SNORM_BLOCK:
+					case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK: case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK: case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK: case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+					case VK_FORMAT_EAC_R11_UNORM_BLOCK: case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+						blockSize = 8;
+					return true;
+					case VK_FORMAT_BC2_UNORM_BLOCK: case VK_FORMAT_BC2_SRGB_BLOCK: case VK_FORMAT_BC3_UNORM_BLOCK: case VK_FORMAT_BC3_SRGB_BLOCK:
+					case VK_FORMAT_BC5_UNORM_BLOCK: case VK_FORMAT_BC5_SNORM_BLOCK: case VK_FORMAT_BC6H_UFLOAT_BLOCK: case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+					case VK_FORMAT_BC7_UNORM_BLOCK: case VK_FORMAT_BC7_SRGB_BLOCK:
+					case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK: case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK: case VK_FORMAT_EAC_R11G11_UNORM_BLOCK: case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+						blockSize = 16;
+					return true;
+					default: break;
+				}
+
+				// Every ASTC LDR block is 16 bytes, only the block footprint varies.
+				blockSize = 16;
+				switch (format) {
+					case VK_FORMAT_ASTC_4x4_UNORM_BLOCK: case VK_FORMAT_ASTC_4x4_SRGB_BLOCK: blockWidth = 4; blockHeight = 4; return true;
+					case VK_FORMAT_ASTC_5x4_UNORM_BLOCK: case VK_FORMAT_ASTC_5x4_SRGB_BLOCK: blockWidth = 5; blockHeight = 4; return true;
+					case VK_FORMAT_ASTC_5x5_UNORM_BLOCK: case VK_FORMAT_ASTC_5x5_SRGB_BLOCK: blockWidth = 5; blockHeight = 5; return true;
+					case VK_FORMAT_ASTC_6x5_UNORM_BLOCK: case VK_FORMAT_ASTC_6x5_SRGB_BLOCK: blockWidth = 6; blockHeight = 5; return true;
+					case VK_FORMAT_ASTC_6x6_UNORM_BLOCK: case VK_FORMAT_ASTC_6x6_SRGB_BLOCK: blockWidth = 6; blockHeight = 6; return true;
+					case VK_FORMAT_ASTC_8x5_UNORM_BLOCK: case VK_FORMAT_ASTC_8x5_SRGB_BLOCK: blockWidth = 8; blockHeight = 5; return true;
+					case VK_FORMAT_ASTC_8x6_UNORM_BLOCK: case VK_FORMAT_ASTC_8x6_SRGB_BLOCK: blockWidth = 8; blockHeight = 6; return true;
+					case VK_FORMAT_ASTC_8x8_UNORM_BLOCK: case VK_FORMAT_ASTC_8x8_SRGB_BLOCK: blockWidth = 8; blockHeight = 8; return true;
+					case VK_FORMAT_ASTC_10x5_UNORM_BLOCK: case VK_FORMAT_ASTC_10x5_SRGB_BLOCK: blockWidth = 10; blockHeight = 5; return true;
+					case VK_FORMAT_ASTC_10x6_UNORM_BLOCK: case VK_FORMAT_ASTC_10x6_SRGB_BLOCK: blockWidth = 10; blockHeight = 6; return true;
+					case VK_FORMAT_ASTC_10x8_UNORM_BLOCK: case VK_FORMAT_ASTC_10x8_SRGB_BLOCK: blockWidth = 10; blockHeight = 8; return true;
+					case VK_FORMAT_ASTC_10x10_UNORM_BLOCK: case VK_FORMAT_ASTC_10x10_SRGB_BLOCK: blockWidth = 10; blockHeight = 10; return true;
+					case VK_FORMAT_ASTC_12x10_UNORM_BLOCK: case VK_FORMAT_ASTC_12x10_SRGB_BLOCK: blockWidth = 12; blockHeight = 10; return true;
+					case VK_FORMAT_ASTC_12x12_UNORM_BLOCK: case VK_FORMAT_ASTC_12x12_SRGB_BLOCK: blockWidth = 12; blockHeight = 12; return true;
+					default: break;
+				}
+
+				blockWidth = blockHeight = 1;
+				blockSize = GetFormatTexelSize(format);
+				return blockSize != 0;
+			}
+
+			/// <summary>Returns true if the format is a block-compressed (BC/ETC2/EAC/ASTC) format.</summary>
+			static bool IsCompressedFormat(VkFormat format) {
+				uint32_t blockWidth, blockHeight;
+				VkDeviceSize blockSize;
+				return GetFormatBlockExtent(format, blockWidth, blockHeight, blockSize) && (blockWidth > 1 || blockHeight > 1);
+			}
+
+			/// <summary>Returns the size in bytes of width x height texels of a format (rounded up to whole blocks for compressed formats).</summary>
+			static VkDeviceSize GetFormatByteSize(VkFormat format, VkDeviceSize width, VkDeviceSize height) {
+				uint32_t blockWidth, blockHeight;
+				VkDeviceSize blockSize;
+				if (!GetFormatBlockExtent(format, blockWidth, blockHeight, blockSize)) return 0;
+				return ((width + blockWidth - 1) / blockWidth) * ((height + blockHeight - 1) / blockHeight) * blockSize;
+			}
+
+			/// <summary>Returns the size in bytes of this image's (mip level 0, array layer 0) texel data.</summary>
+			VkDeviceSize GetImageByteSize() { return GetFormatByteSize(format, width, height); }
+
+			/// <summary>Returns the size in bytes of a mip level's texel data (of all array layers, tightly packed layer 0, 1, 2...).</summary>
+			VkDeviceSize GetMipByteSize(uint32_t level) { return GetFormatByteSize(format, GetMipExtent(width, level), GetMipExtent(height, level)) * arrayLayers; }
+
+			/// <summary>Returns the size in bytes of the first levelCount tightly packed mip levels.</summary>
+			VkDeviceSize GetMipChainByteSize(uint32_t levelCount) {
+				VkDeviceSize size = 0;
+				for (uint32_t level = 0; level < levelCount; level++)
+					size += GetMipByteSize(level);
+
+				return size;
+			}
+
+			/// <summary>Returns the width or height of a mip level (at least 1).</summary>
+			static uint32_t GetMipExtent(VkDeviceSize extent, uint32_t level) { return std::max(1U, static_cast<uint32_t>(extent >> level)); }
+
+			/// <summary>Returns the number of mip levels of a full mip chain (down to 1x1) for an image of width x height.</summary>
+			static uint32_t GetMaxMipLevels(VkDeviceSize width, VkDeviceSize height) {
+				uint32_t levels = 1;
+				for (VkDeviceSize extent = std::max(width, height); extent > 1; extent >>= 1) levels++;
+				return levels;
+			}
+
+			/// <summary>Replaces this image's shared sampler with the cached sampler of the create info (e.g. nearest filtering or repeat addressing).</summary>
+			void SetSampler(const VkSamplerCreateInfo& samplerInfo) {
+				VkSampler sampler = vkdevice.samplerCache.Acquire(samplerInfo);
+				vkdevice.samplerCache.Release(imageSampler);
+				imageSampler = sampler;
+			}
+
 			/// <summary>Creates the data descriptor that represents this image when passing into graphicspipeline.SelectWrite*Descriptor().</summary>
 			VkDescriptorImageInfo GetImageDescriptor() { return { imageSampler, imageView, (VkImageLayout) currentLayout }; }
 
+			/// <summary>Creates the combined image sampler data descriptor of this image sampled with another (e.g. cached) sampler.</summary>
+			VkDescriptorImageInfo GetImageDescriptor(VkSampler sampler) { return { sampler, imageView, (VkImageLayout) currentLayout }; }
+
+			/// <summary>Creates the data descriptor of this image without a sampler (TINYVK_DESCRIPTOR_SAMPLED_IMAGE) to bind samplers independently (TINYVK_DESCRIPTOR_SAMPLER).</summary>
+			VkDescriptorImageInfo GetSampledImageDescriptor() { return { VK_NULL_HANDLE, imageView, (VkImageLayout) currentLayout }; }
+
 			/// <summary>Returns a vec2 UV coordinate converted from this image Width/Height and passed vec2 XY coordinate.</summary>
 			glm::vec2 GetUVCoords(glm::vec2 xy, bool forceClamp = true) {
 				if (forceClamp)
@@ -0,0 +1,284 @@
+#pragma once
+#ifndef TINYVK_TINYVKIMAGEREADBACK
+#define TINYVK_TINYVKIMAGEREADBACK
+	#include "./TinyVulkan.hpp"
+	#include <deque>
+	#include <future>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkImageReadback asynchronously copies TinyVkImages back to the CPU without blocking on vkQueueWaitIdle().
+
+			Each readback request records an image -> buffer copy into one of a pool of readback slots (host-cached
+			persistently mapped VKVMA_BUFFER_TYPE_READBACK buffer, fence and command buffer) and submits it to the
+			graphics queue behind any prior rendering to the image. Poll() delivers every completed readback (in
+			submission order) through onReadbackComplete or the std::future returned by ReadbackFuture().
+
+			The TinyVkReadbackFrame data pointer is only valid for the duration of the onReadbackComplete callback,
+			afterwards the readback slot is recycled for new requests--copy the data out if you need to keep it.
+
+			If all slots are in flight ReadbackAsync() waits for the oldest slot to complete (back-pressure).
+
+			Readbacks lock the image's image_lock while recording, so do not request them from within onRenderEvents
+			(use the TinyVkImageRingRenderer::onFrameSubmitted event instead) or from within onReadbackComplete.
+		*/
+
+		/// <summary>Readback data of a TinyVkImage delivered by the TinyVkImageReadback.</summary>
+		struct TinyVkReadbackFrame {
+			const void* data;
+			VkDeviceSize size;
+			VkDeviceSize width, height;
+			VkFormat format;
+			uint64_t frameId;
+		};
+
+		/// <summary>Asynchronous GPU to CPU image readback using a pool of host-cached persistently mapped buffers.</summary>
+		class TinyVkImageReadback : public TinyVkDisposable {
+		private:
+			struct TinyVkReadbackSlot {
+				TinyVkBuffer* buffer = nullptr;
+				VkFence fence = VK_NULL_HANDLE;
+				std::pair<VkCommandBuffer, int32_t> commandBuffer;
+				TinyVkReadbackFrame frame;
+				std::shared_ptr<std::promise<std::vector<uint8_t>>> promise;
+			};
+
+			TinyVkSpinMutex readback_lock;
+			std::vector<TinyVkReadbackSlot> slots;
+			std::deque<size_t> pendingSlots;
+			std::deque<size_t> freeSlots;
+			TinyVkCommandPool* commandPool;
+
+			void CreateReadbackSlots(size_t slotCount) {
+				VkFenceCreateInfo fenceInfo{};
+				fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+				slots.resize(slotCount);
+				for (size_t i = 0; i < slotCount; i++) {
+					if (vkCreateFence(vkdevice.logicalDevice, &fenceInfo, nullptr, &slots[i].fence) != VK_SUCCESS)
+						throw std::runtime_error("TinyVulkan: Failed to create synchronization objects for image readback!");
+
+					slots[i].commandBuffer = commandPool->LeaseBuffer();
+					freeSlots.push_back(i);
+				}
+			}
+
+			/// <summary>Records and submits the image -> readback buffer copy of the slot.</summary>
+			void SubmitReadback(TinyVkReadbackSlot& slot, TinyVkImage& image) {
+				if (slot.buffer == nullptr || slot.buffer->size < slot.frame.size) {
+					if (slot.buffer != nullptr) {
+						slot.buffer->Dispose(false);
+						delete slot.buffer;
+					}
+
+					slot.buffer = new TinyVkBuffer(vkdevice, graphicsPipeline, *commandPool, slot.frame.size, TinyVkBufferType::VKVMA_BUFFER_TYPE_READBACK);
+				}
+
+				VkCommandBuffer cmdBuffer = slot.commandBuffer.first;
+				vkResetCommandBuffer(cmdBuffer, 0);
+
+				VkCommandBufferBeginInfo beginInfo{};
+				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+				vkBeginCommandBuffer(cmdBuffer, &beginInfo);
+
+				VkImageMemoryBarrier barrier{};
+				barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+				barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+				barrier.oldLayout = (VkImageLayout) image.currentLayout;
+				barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+				barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.image = image.image;
+				barrier.subresourceRange = { image.aspectFlags, 0, 1, 0, 1 };
+				vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+				VkBufferImageCopy region{};
+				region.imageSubresource = { image.aspectFlags, 0, 0, 1 };
+				region.imageExtent = { static_cast<uint32_t>(image.width), static_cast<uint32_t>(image.height), 1 };
+				vkCmdCopyImageToBuffer(cmdBuffer, image.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot.buffer->buffer, 1, &region);
+
+				barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+				barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+				barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+				barrier.newLayout = (VkImageLayout) image.currentLayout;
+
+				VkBufferMemoryBarrier hostBarrier{};
+				hostBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+				hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+				hostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				hostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				hostBarrier.buffer = slot.buffer->buffer;
+				hostBarrier.offset = 0;
+				hostBarrier.size = VK_WHOLE_SIZE;
+
+				if (image.currentLayout != TINYVK_UNDEFINED)
+					vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+				vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &hostBarrier, 0, nullptr);
+
+				if (vkEndCommandBuffer(cmdBuffer) != VK_SUCCESS)
+					throw std::runtime_error("TinyVulkan: Failed to record image readback command buffer!");
+
+				if (image.currentLayout == TINYVK_UNDEFINED)
+					image.currentLayout = TINYVK_TRANSFER_SRC_OPTIMAL;
+
+				VkSubmitInfo submitInfo{};
+				submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+				submitInfo.commandBufferCount = 1;
+				submitInfo.pCommandBuffers = &cmdBuffer;
+
+				vkResetFences(vkdevice.logicalDevice, 1, &slot.fence);
+				if (vkQueueSubmit(graphicsPipeline.GetGraphicsQueue(), 1, &submitInfo, slot.fence) != VK_SUCCESS)
+					throw std::runtime_error("TinyVulkan: Failed to submit image readback command buffer!");
+
+				vkdevice.deletionQueue.SignalSubmission(slot.fence);
+			}
+
+			/// <summary>Delivers the completed readback of the slot and recycles the slot.</summary>
+			void CompleteReadback(size_t slotIndex) {
+				TinyVkReadbackSlot& slot = slots[slotIndex];
+				vmaInvalidateAllocation(vkdevice.GetAllocator(), slot.buffer->memory, 0, VK_WHOLE_SIZE);
+				slot.frame.data = slot.buffer->description.pMappedData;
+
+				if (slot.promise) {
+					const uint8_t* data = static_cast<const uint8_t*>(slot.frame.data);
+					slot.promise->set_value(std::vector<uint8_t>(data, data + slot.frame.size));
+					slot.promise.reset();
+				} else onReadbackComplete.invoke(slot.frame);
+
+				slot.frame.data = nullptr;
+			}
+
+			/// <summary>Queues a readback of the image into a free slot (waits on the oldest slot if all slots are in flight).</summary>
+			size_t QueueReadback(TinyVkImage& image, uint64_t frameId, std::shared_ptr<std::promise<std::vector<uint8_t>>> promise) {
+				VkDeviceSize size = image.GetImageByteSize();
+				if (size == 0)
+					throw std::runtime_error("TinyVulkan: TinyVkImageReadback does not support the image format!");
+
+				TinyVkLockGuard readbackLock(readback_lock);
+				if (freeSlots.empty()) {
+					vkWaitForFences(vkdevice.logicalDevice, 1, &slots[pendingSlots.front()].fence, VK_TRUE, UINT64_MAX);
+					PollCompleted();
+				}
+
+				size_t slotIndex = freeSlots.front();
+				freeSlots.pop_front();
+
+				TinyVkReadbackSlot& slot = slots[slotIndex];
+				slot.frame = { nullptr, size, image.width, image.height, image.format, frameId };
+				slot.promise = promise;
+
+				TinyVkLockGuard imageLock(image.image_lock);
+				SubmitReadback(slot, image);
+				pendingSlots.push_back(slotIndex);
+				return slotIndex;
+			}
+
+			/// <summary>Delivers all completed readbacks in submission order (readback_lock must be held).</summary>
+			size_t PollCompleted() {
+				size_t completed = 0;
+				while (!pendingSlots.empty() && vkGetFenceStatus(vkdevice.logicalDevice, slots[pendingSlots.front()].fence) == VK_SUCCESS) {
+					size_t slotIndex = pendingSlots.front();
+					pendingSlots.pop_front();
+					CompleteReadback(slotIndex);
+					freeSlots.push_back(slotIndex);
+					completed++;
+				}
+
+				return completed;
+			}
+
+		public:
+			TinyVkVulkanDevice& vkdevice;
+			TinyVkGraphicsPipeline& graphicsPipeline;
+
+			/// Invokable Readback Events: (executed in Poll()/Flush() for each completed ReadbackAsync() request)
+			TinyVkInvokable<TinyVkReadbackFrame&> onReadbackComplete;
+
+			TinyVkImageReadback operator=(const TinyVkImageReadback& readback) = delete;
+
+			~TinyVkImageReadback() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				std::vector<VkFence> fences;
+				for (size_t slotIndex : pendingSlots)
+					fences.push_back(slots[slotIndex].fence);
+
+				if (fences.size() > 0)
+					vkWaitForFences(vkdevice.logicalDevice, static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, UINT64_MAX);
+
+				for (TinyVkReadbackSlot& slot : slots) {
+					if (slot.promise) slot.promise->set_exception(std::make_exception_ptr(std::runtime_error("TinyVulkan: TinyVkImageReadback was disposed!")));
+
+					if (slot.buffer != nullptr) {
+						slot.buffer->Dispose(false);
+						delete slot.buffer;
+					}
+
+					vkdevice.deletionQueue.RetireFence(slot.fence);
+					vkDestroyFence(vkdevice.logicalDevice, slot.fence, nullptr);
+				}
+
+				commandPool->Dispose(waitIdle);
+				delete commandPool;
+			}
+
+			/// <summary>Creates an asynchronous image readback with slotCount readbacks that may be in flight at once.</summary>
+			TinyVkImageReadback(TinyVkVulkanDevice& vkdevice, TinyVkGraphicsPipeline& graphicsPipeline, size_t slotCount = 4ULL)
+			: vkdevice(vkdevice), graphicsPipeline(graphicsPipeline) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				if (slotCount == 0)
+					throw std::runtime_error("TinyVulkan: TinyVkImageReadback requires at least 1 readback slot!");
+
+				commandPool = new TinyVkCommandPool(vkdevice, slotCount);
+				CreateReadbackSlots(slotCount);
+
+				SetOwner(vkdevice);
+			}
+
+			/// <summary>Queues an asynchronous readback of the image, delivered through onReadbackComplete by Poll()/Flush().</summary>
+			void ReadbackAsync(TinyVkImage& image, uint64_t frameId = 0) {
+				QueueReadback(image, frameId, nullptr);
+			}
+
+			/// <summary>Queues an asynchronous readback of the image, the future is fulfilled with a copy of the data by Poll()/Flush().</summary>
+			std::future<std::vector<uint8_t>> ReadbackFuture(TinyVkImage& image, uint64_t frameId = 0) {
+				auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+				std::future<std::vector<uint8_t>> future = promise->get_future();
+				QueueReadback(image, frameId, promise);
+				return future;
+			}
+
+			/// <summary>Delivers all completed readbacks without blocking. Returns the number of readbacks delivered.</summary>
+			size_t Poll() {
+				TinyVkLockGuard readbackLock(readback_lock);
+				return PollCompleted();
+			}
+
+			/// <summary>Waits for and delivers all in flight readbacks. Returns the number of readbacks delivered.</summary>
+			size_t Flush() {
+				TinyVkLockGuard readbackLock(readback_lock);
+
+				std::vector<VkFence> fences;
+				for (size_t slotIndex : pendingSlots)
+					fences.push_back(slots[slotIndex].fence);
+
+				if (fences.size() > 0)
+					vkWaitForFences(vkdevice.logicalDevice, static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, UINT64_MAX);
+
+				return PollCompleted();
+			}
+
+			/// <summary>Returns the number of readbacks currently in flight.</summary>
+			size_t GetPendingCount() {
+				TinyVkLockGuard readbackLock(readback_lock);
+				return pendingSlots.size();
+			}
+		};
+	}
+
+#endif
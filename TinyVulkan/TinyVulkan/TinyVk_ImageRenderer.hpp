@@ -14,6 +14,10 @@
 		///				
 		///			If you use a render event, the command buffer will be returned to the command pool queue after execution.
 		///		
+		///		TinyVkImageRingRenderer is for headless rendering to a ring of TinyVkImage render targets, each with its
+		///		own fence, command pool and depth image--so that the next frame is recorded/submitted while previous frames
+		///		are still executing on the GPU or being read back.
+		///		
 		///		TinyVkSwapChainRenderer is for rendering directly to the SwapChain for onscreen rendering.
 		///		Call RenderExecute(mutex[optional]) to render to the swap chain image.
 		///			All swap chain rendering is done via render events and does not accept pre-recorded command buffers.
@@ -27,7 +31,7 @@
 		/// 
 
 		/// <summary>Offscreen Rendering (Render-To-Texture Model): Render to VkImage.</summary>
-		class TinyVkImageRenderer : public TinyVkRendererInterface /*TinyVk_Utilities.hpp*/, TinyVkDisposable {
+		class TinyVkImageRenderer : public TinyVkRendererInterface /*TinyVk_Utilities.hpp*/, public TinyVkDisposable {
 		private:
 			TinyVkImage* optionalDepthImage;
 			TinyVkImage* renderTarget;
@@ -43,13 +47,11 @@
 			~TinyVkImageRenderer() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
-				if (waitIdle) vkDeviceWaitIdle(vkdevice.logicalDevice);
-
-				commandPool->Dispose();
+				commandPool->Dispose(waitIdle);
 				delete commandPool;
 
 				if (graphicsPipeline.DepthTestingIsEnabled()) {
-					optionalDepthImage->Dispose();
+					optionalDepthImage->Dispose(waitIdle);
 					delete optionalDepthImage;
 				}
 			}
@@ -64,16 +66,16 @@
 				optionalDepthImage = nullptr;
 				if (graphicsPipeline.DepthTestingIsEnabled())
 					optionalDepthImage = new TinyVkImage(vkdevice, graphicsPipeline, *commandPool, renderTarget->width, renderTarget->height, true, graphicsPipeline.QueryDepthFormat(), TINYVK_DEPTHSTENCIL_ATTACHMENT_OPTIMAL, VK_SAMPLER_ADDRESS_MODE_REPEAT, VK_IMAGE_ASPECT_DEPTH_BIT);
+
+				SetOwner(vkdevice);
 			}
 
 			TinyVkImageRenderer operator=(const TinyVkImageRenderer& imageRenderer) = delete;
 
 			/// <summary>Sets the target image/texture for the TinyVkImageRenderer.</summary>
 			void SetRenderTarget(TinyVkImage* renderTarget, bool waitOldTarget = true) {
-				if (this->renderTarget != nullptr && waitOldTarget) {
-					vkWaitForFences(vkdevice.logicalDevice, 1, &renderTarget->imageWaitable, VK_TRUE, UINT64_MAX);
-					vkResetFences(vkdevice.logicalDevice, 1, &renderTarget->imageWaitable);
-				}
+				if (this->renderTarget != nullptr && waitOldTarget)
+					vkWaitForFences(vkdevice.logicalDevice, 1, &this->renderTarget->imageWaitable, VK_TRUE, UINT64_MAX);
 
 				this->renderTarget = renderTarget;
 			}
@@ -232,27 +234,34 @@
 				vkCmdPushConstants(cmdBuffer, graphicsPipeline.GetPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, byteSize, pValues);
 			}
 			
-			/// <summary>Executes the registered onRenderEvents and renders them to the target image/texture.</summary>
-			void RenderExecute(VkCommandBuffer preRecordedCmdBuffer = nullptr) {
-				timed_guard imageLock(renderTarget->image_lock);
-				if (!imageLock.Acquired()) return;
-				
+			/// <summary>Returns the current target image/texture of the TinyVkImageRenderer.</summary>
+			TinyVkImage* GetRenderTarget() { return renderTarget; }
+
+			/// <summary>Returns the command pool which the onRenderEvents lease their command buffers from.</summary>
+			TinyVkCommandPool& GetCommandPool() { return *commandPool; }
+
+			/// <summary>Executes the registered onRenderEvents and renders them to the target image/texture. Returns true if the frame was submitted.</summary>
+			bool RenderExecute(VkCommandBuffer preRecordedCmdBuffer = nullptr) {
 				if (renderTarget == nullptr)
-					throw new std::runtime_error("TinyVulkan: RenderTarget for TinyVkImageRenderer is not set [nullptr]!");
+					throw std::runtime_error("TinyVulkan: RenderTarget for TinyVkImageRenderer is not set [nullptr]!");
+
+				TinyVkLockGuard imageLock(renderTarget->image_lock);
 
 				vkWaitForFences(vkdevice.logicalDevice, 1, &renderTarget->imageWaitable, VK_TRUE, UINT64_MAX);
+				// Collect while the fence is still signaled, its submissions are only retired by observing it signaled.
+				vkdevice.deletionQueue.Collect();
 				vkResetFences(vkdevice.logicalDevice, 1, &renderTarget->imageWaitable);
 				
 				//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 				if (graphicsPipeline.DepthTestingIsEnabled()) {
 					TinyVkImage* depthImage = optionalDepthImage;
 					if (depthImage->width != renderTarget->width || depthImage->height != renderTarget->height) {
-						depthImage->Disposable(false);
+						depthImage->Disposable(true);
 						depthImage->ReCreateImage(renderTarget->width, renderTarget->height, depthImage->isDepthImage, graphicsPipeline.QueryDepthFormat(), TINYVK_DEPTHSTENCIL_ATTACHMENT_OPTIMAL, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_IMAGE_ASPECT_DEPTH_BIT);
 					}
 				}
 				
-				vkResetCommandPool(vkdevice.logicalDevice, commandPool->GetPool(), 0);
+				commandPool->ReturnAllBuffers(true);
 				onRenderEvents.invoke(*commandPool);
 				//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -268,6 +277,9 @@
 
 				if (vkQueueSubmit(graphicsPipeline.GetGraphicsQueue(), 1, &submitInfo, renderTarget->imageWaitable) != VK_SUCCESS)
 					throw std::runtime_error("TinyVulkan: Failed to submit draw command buffer!");
+
+				vkdevice.deletionQueue.SignalSubmission(renderTarget->imageWaitable);
+				return true;
 			}
 		};
 	}
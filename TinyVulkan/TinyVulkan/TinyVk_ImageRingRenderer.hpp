@@ -0,0 +1,127 @@
+#pragma once
+#ifndef TINYVK_TINYVKIMAGERINGRENDERER
+#define TINYVK_TINYVKIMAGERINGRENDERER
+	#include "./TinyVulkan.hpp"
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkImageRingRenderer is a headless (offscreen) renderer which renders to a ring of N TinyVkImage
+			render targets, similar to the TinyVkResourceQueue. Each frame in the ring has its own render target, fence,
+			command pool and depth image (one TinyVkImageRenderer per frame), so RenderExecute() only blocks once the ring
+			is full--submission of frame N+1 overlaps GPU execution (and readback) of frame N.
+
+			Rendering:
+				onRenderEvents += callback<TinyVkCommandPool&>(...);
+					Use GetFrameRenderer() inside of the render event to Begin/EndRecordCmdBuffer() to the current frame.
+				onFrameSubmitted += callback<size_t, TinyVkImage&>(...);
+					Invoked after a frame is submitted with the frame index and its render target (e.g. for queueing readbacks).
+		*/
+
+		/// <summary>Offscreen Rendering (Render-To-Texture Model): Render to a ring of VkImages with multiple frames in flight.</summary>
+		class TinyVkImageRingRenderer : public TinyVkDisposable {
+		private:
+			std::vector<TinyVkImage*> renderTargets;
+			std::vector<TinyVkImageRenderer*> renderers;
+			TinyVkCommandPool* targetPool;
+			size_t currentFrame = 0;
+			uint64_t frameCount = 0;
+
+		public:
+			TinyVkVulkanDevice& vkdevice;
+			TinyVkGraphicsPipeline& graphicsPipeline;
+
+			/// Invokable Render Events: (executed in TinyVkImageRingRenderer::RenderExecute() for the current frame)
+			TinyVkInvokable<TinyVkCommandPool&> onRenderEvents;
+			/// Invokable Submit Events: (executed after each frame is submitted with its frame index and render target)
+			TinyVkInvokable<size_t, TinyVkImage&> onFrameSubmitted;
+
+			~TinyVkImageRingRenderer() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				for (TinyVkImageRenderer* renderer : renderers) {
+					renderer->Dispose(waitIdle);
+					delete renderer;
+				}
+
+				for (TinyVkImage* renderTarget : renderTargets) {
+					renderTarget->Dispose(waitIdle);
+					delete renderTarget;
+				}
+
+				targetPool->Dispose(waitIdle);
+				delete targetPool;
+			}
+
+			/// <summary>Creates a headless renderer with a ring of ringSize render targets (frames in flight).</summary>
+			TinyVkImageRingRenderer(TinyVkVulkanDevice& vkdevice, TinyVkGraphicsPipeline& graphicsPipeline, VkDeviceSize width, VkDeviceSize height, size_t ringSize = 3ULL, VkFormat format = VK_FORMAT_B8G8R8A8_SRGB, size_t cmdpoolbuffercount = 32ULL)
+			: vkdevice(vkdevice), graphicsPipeline(graphicsPipeline) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				if (ringSize == 0)
+					throw std::runtime_error("TinyVulkan: TinyVkImageRingRenderer requires a ring size of at least 1!");
+
+				targetPool = new TinyVkCommandPool(vkdevice, ringSize);
+
+				for (size_t i = 0; i < ringSize; i++) {
+					TinyVkImage* renderTarget = new TinyVkImage(vkdevice, graphicsPipeline, *targetPool, width, height, false, format, TINYVK_SHADER_READONLY_OPTIMAL);
+					TinyVkImageRenderer* renderer = new TinyVkImageRenderer(vkdevice, renderTarget, graphicsPipeline, cmdpoolbuffercount);
+					renderer->onRenderEvents.hook(TinyVkCallback<TinyVkCommandPool&>([this](TinyVkCommandPool& commandPool) { this->onRenderEvents.invoke(commandPool); }));
+
+					renderTargets.push_back(renderTarget);
+					renderers.push_back(renderer);
+				}
+
+				SetOwner(vkdevice);
+			}
+
+			TinyVkImageRingRenderer operator=(const TinyVkImageRingRenderer& ringRenderer) = delete;
+
+			/// <summary>Returns the number of render targets (frames in flight) in the ring.</summary>
+			size_t GetRingSize() { return renderTargets.size(); }
+
+			/// <summary>Returns the ring index of the frame that will be rendered next (or is being recorded within onRenderEvents).</summary>
+			size_t GetFrameIndex() { return currentFrame; }
+
+			/// <summary>Returns the total number of frames submitted by this renderer.</summary>
+			uint64_t GetFrameCount() { return frameCount; }
+
+			/// <summary>Returns the image renderer of the current frame for recording render commands.</summary>
+			TinyVkImageRenderer& GetFrameRenderer() { return *renderers[currentFrame]; }
+
+			/// <summary>Returns the render target of the current frame.</summary>
+			TinyVkImage& GetFrameTarget() { return *renderTargets[currentFrame]; }
+
+			/// <summary>Returns the render target at the ring index.</summary>
+			TinyVkImage& GetRenderTarget(size_t index) { return *renderTargets[index % renderTargets.size()]; }
+
+			/// <summary>Waits for the frame at the ring index to finish rendering on the GPU.</summary>
+			void WaitFrame(size_t index) {
+				TinyVkImage& renderTarget = GetRenderTarget(index);
+				vkWaitForFences(vkdevice.logicalDevice, 1, &renderTarget.imageWaitable, VK_TRUE, UINT64_MAX);
+			}
+
+			/// <summary>Waits for all frames in the ring to finish rendering on the GPU (without waiting on the whole device).</summary>
+			void WaitAllFrames() {
+				std::vector<VkFence> fences;
+				for (TinyVkImage* renderTarget : renderTargets)
+					fences.push_back(renderTarget->imageWaitable);
+
+				vkWaitForFences(vkdevice.logicalDevice, static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, UINT64_MAX);
+			}
+
+			/// <summary>Renders the next frame in the ring (only waits if that frame's previous submission is still in flight). Returns the rendered frame index.</summary>
+			size_t RenderExecute() {
+				size_t frame = currentFrame;
+				renderers[frame]->RenderExecute();
+
+				renderTargets[frame]->currentLayout = TINYVK_SHADER_READONLY_OPTIMAL; // Layout after TinyVkImageRenderer::EndRecordCmdBuffer().
+				onFrameSubmitted.invoke(frame, *renderTargets[frame]);
+
+				currentFrame = (currentFrame + 1) % renderTargets.size();
+				frameCount++;
+				return frame;
+			}
+		};
+	}
+
+#endif
@@ -0,0 +1,181 @@
+#pragma once
+#ifndef TINYVK_TINYVKINPUTSTATE
+#define TINYVK_TINYVKINPUTSTATE
+	#include "./TinyVulkan.hpp"
+	#include <array>
+	#include <atomic>
+	#include <cstdint>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			TinyVkInputState packs every keyboard key, mouse button and gamepad button into one array of 64-bit words
+			(TinyVkInputBits), so input queries are a shift and mask instead of a hash lookup.
+
+			Input handlers (any thread) update the live state with atomic word operations and latch every press/release
+			transition. Once per frame PublishSnapshot() builds the next TinyVkInputSnapshot from the live words with
+			word-wide bitwise ops (down, pressed, released and held masks) into the back buffer of a double buffer and
+			flips it, so a press and release within a single frame still reports both edges.
+
+			GetSnapshot() returns the published, immutable snapshot: it stays valid until the second PublishSnapshot()
+			after it was returned (one full frame), copy it if it must outlive that.
+		*/
+
+		/// <summary>Packed button bitset: keyboard keys, then mouse buttons, then 16 buttons per gamepad.</summary>
+		struct TinyVkInputBits {
+			static constexpr size_t KeyCount = GLFW_KEY_LAST + 1;
+			static constexpr size_t MouseWord = (KeyCount + 63) / 64;
+			static constexpr size_t GamepadWord = MouseWord + 1;
+			static constexpr size_t GamepadCount = GLFW_JOYSTICK_LAST + 1;
+			static constexpr size_t GamepadStride = 16;
+			static constexpr size_t WordCount = GamepadWord + ((GamepadCount * GamepadStride) + 63) / 64;
+			static constexpr size_t InvalidBit = WordCount * 64;
+
+			std::array<uint64_t, WordCount> words {};
+
+			/// <summary>Returns the bit index of a keyboard key (InvalidBit for unknown keys).</summary>
+			static constexpr size_t KeyBit(TinyVkKeyboardButtons key) {
+				int32_t code = static_cast<int32_t>(key);
+				return (code >= 0 && code < static_cast<int32_t>(KeyCount)) ? static_cast<size_t>(code) : InvalidBit;
+			}
+
+			/// <summary>Returns the bit index of a mouse button (InvalidBit for unknown buttons).</summary>
+			static constexpr size_t MouseBit(TinyVkMouseButtons button) {
+				int32_t code = static_cast<int32_t>(button);
+				return (code >= 0 && code <= GLFW_MOUSE_BUTTON_LAST) ? (MouseWord * 64) + static_cast<size_t>(code) : InvalidBit;
+			}
+
+			/// <summary>Returns the bit index of a gamepad button (InvalidBit for unknown gamepads/buttons).</summary>
+			static constexpr size_t GamepadBit(TinyVkGamepads gpad, TinyVkGamepadButtons button) {
+				int32_t pad = static_cast<int32_t>(gpad), code = static_cast<int32_t>(button);
+				return (pad >= 0 && pad < static_cast<int32_t>(GamepadCount) && code >= 0 && code <= GLFW_GAMEPAD_BUTTON_LAST)
+					? (GamepadWord * 64) + (static_cast<size_t>(pad) * GamepadStride) + static_cast<size_t>(code) : InvalidBit;
+			}
+
+			/// <summary>Returns true if the bit is set.</summary>
+			bool Test(size_t bit) const { return bit < InvalidBit && (words[bit >> 6] >> (bit & 63)) & 1ULL; }
+		};
+
+		/// <summary>Immutable per-frame input state: button down/pressed/released/held masks, mouse and gamepad axes.</summary>
+		struct TinyVkInputSnapshot {
+			/// <summary>Number of snapshots published before this one.</summary>
+			uint64_t frame = 0;
+			/// <summary>Buttons down at publish, pressed/released during the frame, and down in both this and the previous frame.</summary>
+			TinyVkInputBits down, pressed, released, held;
+			double_t mouseX = 0.0, mouseY = 0.0;
+			/// <summary>Scroll offsets accumulated during the frame.</summary>
+			double_t scrollX = 0.0, scrollY = 0.0;
+			bool mouseInside = false;
+			std::array<float_t, TinyVkInputBits::GamepadCount * (GLFW_GAMEPAD_AXIS_LAST + 1)> gamepadAxes {};
+
+			bool IsKeyDown(TinyVkKeyboardButtons key) const { return down.Test(TinyVkInputBits::KeyBit(key)); }
+			bool IsKeyPressed(TinyVkKeyboardButtons key) const { return pressed.Test(TinyVkInputBits::KeyBit(key)); }
+			bool IsKeyReleased(TinyVkKeyboardButtons key) const { return released.Test(TinyVkInputBits::KeyBit(key)); }
+			bool IsKeyHeld(TinyVkKeyboardButtons key) const { return held.Test(TinyVkInputBits::KeyBit(key)); }
+
+			bool IsMouseDown(TinyVkMouseButtons button) const { return down.Test(TinyVkInputBits::MouseBit(button)); }
+			bool IsMousePressed(TinyVkMouseButtons button) const { return pressed.Test(TinyVkInputBits::MouseBit(button)); }
+			bool IsMouseReleased(TinyVkMouseButtons button) const { return released.Test(TinyVkInputBits::MouseBit(button)); }
+			bool IsMouseHeld(TinyVkMouseButtons button) const { return held.Test(TinyVkInputBits::MouseBit(button)); }
+
+			bool IsGamepadDown(TinyVkGamepads gpad, TinyVkGamepadButtons button) const { return down.Test(TinyVkInputBits::GamepadBit(gpad, button)); }
+			bool IsGamepadPressed(TinyVkGamepads gpad, TinyVkGamepadButtons button) const { return pressed.Test(TinyVkInputBits::GamepadBit(gpad, button)); }
+			bool IsGamepadReleased(TinyVkGamepads gpad, TinyVkGamepadButtons button) const { return released.Test(TinyVkInputBits::GamepadBit(gpad, button)); }
+			bool IsGamepadHeld(TinyVkGamepads gpad, TinyVkGamepadButtons button) const { return held.Test(TinyVkInputBits::GamepadBit(gpad, button)); }
+
+			/// <summary>Returns the last value of a gamepad axis (0 for unknown gamepads/axes).</summary>
+			float_t GetGamepadAxis(TinyVkGamepads gpad, TinyVkGamepadAxis axis) const {
+				int32_t pad = static_cast<int32_t>(gpad), code = static_cast<int32_t>(axis);
+				if (pad < 0 || pad >= static_cast<int32_t>(TinyVkInputBits::GamepadCount) || code < 0 || code > GLFW_GAMEPAD_AXIS_LAST) return 0.0f;
+				return gamepadAxes[(static_cast<size_t>(pad) * (GLFW_GAMEPAD_AXIS_LAST + 1)) + static_cast<size_t>(code)];
+			}
+		};
+
+		/// <summary>Live packed input state updated by input handlers and published once per frame as a double-buffered TinyVkInputSnapshot.</summary>
+		class TinyVkInputState {
+		private:
+			std::array<std::atomic<uint64_t>, TinyVkInputBits::WordCount> down {}, latchedPressed {}, latchedReleased {};
+			std::array<std::atomic<float_t>, TinyVkInputBits::GamepadCount * (GLFW_GAMEPAD_AXIS_LAST + 1)> gamepadAxes {};
+			std::atomic<double_t> mouseX = 0.0, mouseY = 0.0, scrollX = 0.0, scrollY = 0.0;
+			std::atomic<bool> mouseInside = false;
+
+			TinyVkSpinMutex publish_lock;
+			TinyVkInputSnapshot snapshots[2];
+			std::atomic<uint32_t> front = 0;
+
+		public:
+			TinyVkInputState() = default;
+			TinyVkInputState(const TinyVkInputState&) = delete;
+			TinyVkInputState& operator=(const TinyVkInputState&) = delete;
+
+			/// <summary>Sets a button bit down or up (InvalidBit is ignored), latching the press/release transition for the next snapshot.</summary>
+			void SetButton(size_t bit, bool isDown) {
+				if (bit >= TinyVkInputBits::InvalidBit) return;
+
+				uint64_t mask = 1ULL << (bit & 63);
+				if (isDown) {
+					if ((down[bit >> 6].fetch_or(mask, std::memory_order_acq_rel) & mask) == 0)
+						latchedPressed[bit >> 6].fetch_or(mask, std::memory_order_release);
+				} else {
+					if ((down[bit >> 6].fetch_and(~mask, std::memory_order_acq_rel) & mask) != 0)
+						latchedReleased[bit >> 6].fetch_or(mask, std::memory_order_release);
+				}
+			}
+
+			/// <summary>Returns true if a button bit is currently down (live state, not the published snapshot).</summary>
+			bool IsButtonDown(size_t bit) const {
+				return bit < TinyVkInputBits::InvalidBit && (down[bit >> 6].load(std::memory_order_acquire) >> (bit & 63)) & 1ULL;
+			}
+
+			void SetMousePosition(double_t xpos, double_t ypos) {
+				mouseX.store(xpos, std::memory_order_relaxed);
+				mouseY.store(ypos, std::memory_order_relaxed);
+			}
+
+			void AddMouseScroll(double_t xoffset, double_t yoffset) {
+				scrollX.fetch_add(xoffset, std::memory_order_relaxed);
+				scrollY.fetch_add(yoffset, std::memory_order_relaxed);
+			}
+
+			void SetMouseInside(bool inside) { mouseInside.store(inside, std::memory_order_relaxed); }
+
+			void SetGamepadAxis(TinyVkGamepads gpad, TinyVkGamepadAxis axis, float_t value) {
+				int32_t pad = static_cast<int32_t>(gpad), code = static_cast<int32_t>(axis);
+				if (pad < 0 || pad >= static_cast<int32_t>(TinyVkInputBits::GamepadCount) || code < 0 || code > GLFW_GAMEPAD_AXIS_LAST) return;
+				gamepadAxes[(static_cast<size_t>(pad) * (GLFW_GAMEPAD_AXIS_LAST + 1)) + static_cast<size_t>(code)].store(value, std::memory_order_relaxed);
+			}
+
+			/// <summary>Builds the next snapshot from the live state and publishes it (call once per frame), returns the published snapshot.</summary>
+			const TinyVkInputSnapshot& PublishSnapshot() {
+				TinyVkLockGuard g(publish_lock);
+				uint32_t back = front.load(std::memory_order_relaxed) ^ 1;
+				const TinyVkInputSnapshot& previous = snapshots[back ^ 1];
+				TinyVkInputSnapshot& next = snapshots[back];
+
+				// Edges come from the latched transitions (exact even for a press and release within one frame).
+				for (size_t w = 0; w < TinyVkInputBits::WordCount; w++) {
+					uint64_t current = down[w].load(std::memory_order_acquire);
+					next.down.words[w] = current;
+					next.pressed.words[w] = latchedPressed[w].exchange(0, std::memory_order_acq_rel);
+					next.released.words[w] = latchedReleased[w].exchange(0, std::memory_order_acq_rel);
+					next.held.words[w] = current & previous.down.words[w] & ~next.pressed.words[w];
+				}
+
+				for (size_t a = 0; a < gamepadAxes.size(); a++)
+					next.gamepadAxes[a] = gamepadAxes[a].load(std::memory_order_relaxed);
+
+				next.mouseX = mouseX.load(std::memory_order_relaxed);
+				next.mouseY = mouseY.load(std::memory_order_relaxed);
+				next.scrollX = scrollX.exchange(0.0, std::memory_order_relaxed);
+				next.scrollY = scrollY.exchange(0.0, std::memory_order_relaxed);
+				next.mouseInside = mouseInside.load(std::memory_order_relaxed);
+				next.frame = previous.frame + 1;
+
+				front.store(back, std::memory_order_release);
+				return next;
+			}
+
+			/// <summary>Returns the last published snapshot (valid until the second PublishSnapshot() after this call).</summary>
+			const TinyVkInputSnapshot& GetSnapshot() const { return snapshots[front.load(std::memory_order_acquire)]; }
+		};
+	}
+#endif
@@ -3,24 +3,96 @@
 #pragma once
 #ifndef TINYVK_TINYVKINVOKABLECALLBACK
 #define TINYVK_TINYVKINVOKABLECALLBACK
+    #include <atomic>
+    #include <cstddef>
     #include <functional>
+    #include <new>
     #include <vector>
     #include <mutex>
     #include <utility>
     #include <type_traits>
 
     namespace TINYVULKAN_NAMESPACE {
+        /*
+            TinyVkInvokable events are invoked far more often than they are hooked (onRenderEvents every frame, input
+            events per key/mouse move), so the registered callbacks are kept in an immutable, atomically swapped
+            snapshot: hook()/unhook()/rehook()/empty() copy the current list under the lock and publish a new one,
+            invoke() only loads the current snapshot and calls its callbacks in place (no lock, copy or allocation).
+
+            Replaced snapshots are freed by the next hook/unhook that finds no invoke() running (RCU style reader count),
+            so callbacks hooked or unhooked during an invoke() take effect from the next invoke(). invoke_blocking()
+            holds the lock while invoking, so hooks wait for it to return.
+        */
+
+        #ifndef TINYVK_CALLBACK_CAPACITY
+            #define TINYVK_CALLBACK_CAPACITY 96
+        #endif
+
+        /// Source of unique TinyVkCallback registration handles (0 is an empty TinyVkCallback).
+        inline std::atomic<size_t> TinyVkCallbackHandles = 1;
+
+        /*
+            TinyVkCallback is a fixed-capacity delegate: the bound function (lambda captures, function pointer, etc.) is
+            stored inline in TINYVK_CALLBACK_CAPACITY bytes (define it before including TinyVulkan to change it), so
+            creating, copying and invoking a TinyVkCallback never allocates. Larger functions fail to compile.
+            Invoking costs a single indirect call through the per-function-type operation table.
+
+            Every constructed TinyVkCallback gets a unique handle (hash_code()), copies share the handle of the
+            TinyVkCallback they were copied from, so unhook() removes exactly the registration it is given, even
+            when several lambdas of the same type are hooked.
+        */
+
         template<typename... A>
         class TinyVkCallback {
         protected:
-            /// Unique identifying hash code.
-            size_t hash;
-            /// The function bound to this TinyVkCallback.
-            std::function<void(A...)> bound;
+            /// Type-erased operations of the bound function type.
+            struct TinyVkCallbackOps {
+                void (*call)(void* target, A&... args);
+                void (*copy)(void* destination, const void* source);
+                void (*destroy)(void* target);
+            };
+
+            template<typename F>
+            inline static const TinyVkCallbackOps operations = {
+                [](void* target, A&... args) { (*static_cast<F*>(target))(args...); },
+                [](void* destination, const void* source) { new (destination) F(*static_cast<const F*>(source)); },
+                [](void* target) { static_cast<F*>(target)->~F(); }
+            };
+
+            /// Unique identifying registration handle.
+            size_t hash = 0;
+            /// Operation table of the function bound to this TinyVkCallback (nullptr if empty).
+            const TinyVkCallbackOps* ops = nullptr;
+            /// Inline storage of the function bound to this TinyVkCallback.
+            alignas(std::max_align_t) mutable unsigned char bound[TINYVK_CALLBACK_CAPACITY];
 
         public:
+            /// Creates an empty TinyVkCallback (invoking it does nothing).
+            TinyVkCallback() = default;
+
             // Create a new TinyVkCallback with the specified arguments.
-            TinyVkCallback(std::function<void(A...)> func) : hash(func.target_type().hash_code()), bound(std::move(func)) {}
+            template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, TinyVkCallback<A...>> && std::is_invocable_v<std::decay_t<F>&, A&...>>>
+            TinyVkCallback(F&& func) : hash(TinyVkCallbackHandles.fetch_add(1, std::memory_order_relaxed)), ops(&operations<std::decay_t<F>>) {
+                static_assert(sizeof(std::decay_t<F>) <= TINYVK_CALLBACK_CAPACITY, "TinyVulkan: TinyVkCallback function exceeds TINYVK_CALLBACK_CAPACITY bytes (capture less or raise the capacity)!");
+                static_assert(alignof(std::decay_t<F>) <= alignof(std::max_align_t), "TinyVulkan: TinyVkCallback function is over-aligned!");
+                new (bound) std::decay_t<F>(std::forward<F>(func));
+            }
+
+            TinyVkCallback(const TinyVkCallback<A...>& cb) : hash(cb.hash), ops(cb.ops) {
+                if (ops != nullptr) ops->copy(bound, cb.bound);
+            }
+
+            TinyVkCallback<A...>& operator=(const TinyVkCallback<A...>& cb) {
+                if (this == &cb) return (*this);
+                if (ops != nullptr) ops->destroy(bound);
+
+                hash = cb.hash;
+                ops = cb.ops;
+                if (ops != nullptr) ops->copy(bound, cb.bound);
+                return (*this);
+            }
+
+            ~TinyVkCallback() { if (ops != nullptr) ops->destroy(bound); }
 
             /// Compares the underlying hash_code of the TinyVkCallback function(s).
             bool operator == (const TinyVkCallback<A...>& cb) { return hash == cb.hash; }
@@ -28,67 +100,137 @@
             /// Inequality Compares the underlying hash_code of the TinyVkCallback function(s).
             bool operator != (const TinyVkCallback<A...>& cb) { return hash != cb.hash; }
         
-            /// Returns the unique hash code for this TinyVkCallback function.
+            /// Returns the unique registration handle for this TinyVkCallback function (shared by its copies).
             constexpr size_t hash_code() const throw() { return hash; }
+
+            /// Returns true if a function is bound to this TinyVkCallback.
+            bool bound_function() const { return ops != nullptr; }
         
             /// Invoke this TinyVkCallback with required arguments.
-            TinyVkCallback<A...>& invoke(A... args) { bound(static_cast<A&&>(args)...); return (*this); }
+            TinyVkCallback<A...>& invoke(A... args) { call(args...); return (*this); }
 
             /// Operator() invoke this TinyVkCallback with required arguments.
-            void operator()(A... args) { bound(static_cast<A&&>(args)...); }
+            void operator()(A... args) { call(args...); }
+
+            /// Invoke this TinyVkCallback from a (shared, immutable) snapshot, arguments are passed on as lvalues.
+            void call(A&... args) const { if (ops != nullptr) ops->call(bound, args...); }
         };
 
         template<typename... A>
         class TinyVkInvokable {
         protected:
-            /// Resource lock for thread-safe accessibility.
-            std::timed_mutex safety_lock;
-            /// Record of stored TinyVkCallbacks to invoke.
-            std::vector<TinyVkCallback<A...>> TinyVkCallbacks;
+            typedef std::vector<TinyVkCallback<A...>> TinyVkCallbackList;
+
+            /// Resource lock for thread-safe accessibility (serializes hook/unhook/invoke_blocking).
+            TinyVkSpinMutex safety_lock;
+            /// Immutable snapshot of the stored TinyVkCallbacks to invoke (nullptr while no TinyVkCallback is registered).
+            std::atomic<const TinyVkCallbackList*> TinyVkCallbacks = nullptr;
+            /// Number of invoke() calls currently reading a snapshot.
+            std::atomic<size_t> readers = 0;
+            /// Replaced snapshots that may still be read by a running invoke() (freed once no invoke() is running).
+            std::vector<const TinyVkCallbackList*> retired;
+
+            /// Publishes a new snapshot and frees retired snapshots if no invoke() is running (call with the safety_lock held).
+            void publish(const TinyVkCallbackList* callbacks) {
+                retired.push_back(TinyVkCallbacks.exchange(callbacks));
+
+                // Readers register before loading the snapshot: with none registered, none can still hold a retired snapshot.
+                if (readers.load() == 0) {
+                    for (const TinyVkCallbackList* list : retired) delete list;
+                    retired.clear();
+                }
+            }
+
+            /// Publishes a modified copy of the current snapshot (call with the safety_lock held).
+            template<typename F>
+            void modify(F change) {
+                const TinyVkCallbackList* current = TinyVkCallbacks.load();
+                TinyVkCallbackList callbacks = (current != nullptr) ? *current : TinyVkCallbackList();
+                change(callbacks);
+                publish((callbacks.empty()) ? nullptr : new TinyVkCallbackList(std::move(callbacks)));
+            }
 
         public:
+            TinyVkInvokable() = default;
+            TinyVkInvokable(const TinyVkInvokable&) = delete;
+            TinyVkInvokable& operator=(const TinyVkInvokable&) = delete;
+
+            ~TinyVkInvokable() {
+                delete TinyVkCallbacks.load();
+                for (const TinyVkCallbackList* list : retired) delete list;
+            }
+
             /// Adds a TinyVkCallback to this event, operator +=
             TinyVkInvokable<A...>& hook(const TinyVkCallback<A...> cb) {
-                timed_guard<false> g(safety_lock);
-                TinyVkCallbacks.push_back(cb);
+                TinyVkLockGuard g(safety_lock);
+                modify([&cb](TinyVkCallbackList& callbacks) { callbacks.push_back(cb); });
                 return (*this);
             }
 
             /// Removes a TinyVkCallback from this event, operator -=
             TinyVkInvokable<A...>& unhook(const TinyVkCallback<A...> cb) {
-                timed_guard<false> g(safety_lock);
-                std::erase_if(TinyVkCallbacks, [cb](TinyVkCallback<A...> c){ return cb.hash_code() == c.hash_code(); });
+                TinyVkLockGuard g(safety_lock);
+                modify([&cb](TinyVkCallbackList& callbacks) {
+                    std::erase_if(callbacks, [&cb](const TinyVkCallback<A...>& c){ return cb.hash_code() == c.hash_code(); });
+                });
+                return (*this);
+            }
+
+            /// Removes the TinyVkCallback(s) registered with the handle (TinyVkCallback::hash_code()).
+            TinyVkInvokable<A...>& unhook(size_t handle) {
+                TinyVkLockGuard g(safety_lock);
+                modify([handle](TinyVkCallbackList& callbacks) {
+                    std::erase_if(callbacks, [handle](const TinyVkCallback<A...>& c){ return c.hash_code() == handle; });
+                });
                 return (*this);
             }
 
             /// Removes all registered TinyVkCallbacks and adds a new TinyVkCallback, operator =
             TinyVkInvokable<A...>& rehook(const TinyVkCallback<A...> cb) {
-                timed_guard<false> g(safety_lock);
-                TinyVkCallbacks.clear();
-                TinyVkCallbacks.push_back(cb);
+                TinyVkLockGuard g(safety_lock);
+                publish(new TinyVkCallbackList { cb });
                 return (*this);
             }
 
             /// Removes all registered TinyVkCallbacks.
             TinyVkInvokable<A...>& empty() {
-                timed_guard<false> g(safety_lock);
-                TinyVkCallbacks.clear();
+                TinyVkLockGuard g(safety_lock);
+                publish(nullptr);
                 return (*this);
             }
 
-            /// Execute all registered TinyVkCallbacks, operator ()
+            /// Returns the number of registered TinyVkCallbacks.
+            size_t count() {
+                TinyVkLockGuard g(safety_lock);
+                const TinyVkCallbackList* callbacks = TinyVkCallbacks.load();
+                return (callbacks != nullptr) ? callbacks->size() : 0;
+            }
+
+            /// Execute all registered TinyVkCallbacks (lock-free and allocation-free), operator ()
             TinyVkInvokable<A...>& invoke(A... args) {
-                timed_guard<false> g(safety_lock);
-                std::vector<TinyVkCallback<A...>> clonecb(TinyVkCallbacks);
-                g.Unlock();
-                for (TinyVkCallback<A...> cb : clonecb) cb.invoke(static_cast<A&&>(args)...);
+                if (TinyVkCallbacks.load(std::memory_order_relaxed) == nullptr) return (*this);
+
+                readers.fetch_add(1);
+                const TinyVkCallbackList* callbacks = TinyVkCallbacks.load();
+                try {
+                    if (callbacks != nullptr)
+                        for (const TinyVkCallback<A...>& cb : *callbacks) cb.call(args...);
+                } catch (...) {
+                    readers.fetch_sub(1);
+                    throw;
+                }
+
+                readers.fetch_sub(1);
                 return (*this);
             }
 
-            /// Execute all registered TinyVkCallbacks, operator ()
+            /// Execute all registered TinyVkCallbacks while holding the lock (hook/unhook wait until every TinyVkCallback returns), operator ()
             TinyVkInvokable<A...>& invoke_blocking(A... args) {
-                timed_guard<false> g(safety_lock);
-                for (TinyVkCallback<A...> cb : TinyVkCallbacks) cb.invoke(static_cast<A&&>(args)...);
+                TinyVkLockGuard g(safety_lock);
+                const TinyVkCallbackList* callbacks = TinyVkCallbacks.load();
+                if (callbacks != nullptr)
+                    for (const TinyVkCallback<A...>& cb : *callbacks) cb.call(args...);
+
                 return (*this);
             }
         };
@@ -0,0 +1,301 @@
+#pragma once
+#ifndef TINYVK_TINYVKJOBSYSTEM
+#define TINYVK_TINYVKJOBSYSTEM
+	#include "./TinyVulkan.hpp"
+	#include <atomic>
+	#include <deque>
+	#include <exception>
+	#include <memory>
+	#include <thread>
+	#include <vector>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			TinyVkJobSystem is a work-stealing thread pool for the library's CPU work (QOI/BC decoding and encoding, asset
+			streaming, batch encoding) and the application's:
+
+				Each worker owns a job deque: jobs it runs push to (and pop from) the back of its own deque (LIFO, cache warm),
+				idle workers steal from the front of the other deques (FIFO, oldest/largest work first). Jobs run from
+				threads outside the pool go to a shared injection deque which every worker steals from.
+				Idle workers park on an atomic (C++20 wait/notify) and are woken by Run().
+
+			Jobs are TinyVkJobs (allocation-free TinyVkCallback<>). A TinyVkJobCounter counts unfinished jobs:
+				Wait(counter) runs other queued jobs while it waits (so jobs may Wait() on nested jobs without blocking a
+				worker), RunAfter(counter, job) is a continuation that is queued once every job of the counter finished.
+				The first exception thrown by a job with a counter is rethrown by Wait(), jobs without a counter must not throw.
+
+			ParallelFor(count, task) runs task(index) across the pool and the calling thread and waits for it.
+			Default() is the shared pool (hardware threads - 1 workers) used by the library.
+		*/
+
+		/// <summary>Job run by the TinyVkJobSystem (must not throw unless run with a TinyVkJobCounter).</summary>
+		typedef TinyVkCallback<> TinyVkJob;
+
+		/// <summary>Counts unfinished jobs for TinyVkJobSystem::Wait() and runs continuations once they are finished (must outlive its jobs).</summary>
+		class TinyVkJobCounter {
+		private:
+			friend class TinyVkJobSystem;
+
+			std::atomic<size_t> pending = 0;
+			TinyVkSpinMutex counter_lock;
+			std::vector<std::pair<TinyVkJob, TinyVkJobCounter*>> continuations;
+			std::exception_ptr error = nullptr;
+
+		public:
+			TinyVkJobCounter() = default;
+			TinyVkJobCounter(const TinyVkJobCounter&) = delete;
+			TinyVkJobCounter& operator=(const TinyVkJobCounter&) = delete;
+
+			/// <summary>Returns the number of unfinished jobs.</summary>
+			size_t Pending() const { return pending.load(std::memory_order_acquire); }
+
+			/// <summary>Returns true if every job has finished.</summary>
+			bool Done() const { return Pending() == 0; }
+		};
+
+		/// <summary>Work-stealing thread pool with per-worker job deques, job counters/continuations and parallel-for.</summary>
+		class TinyVkJobSystem {
+		private:
+			struct TinyVkJobEntry {
+				TinyVkJob job;
+				TinyVkJobCounter* counter;
+			};
+
+			struct alignas(64) TinyVkJobDeque {
+				TinyVkSpinMutex deque_lock;
+				std::deque<TinyVkJobEntry> entries;
+			};
+
+			/// Worker deques followed by the injection deque of threads outside the pool.
+			std::vector<std::unique_ptr<TinyVkJobDeque>> deques;
+			std::vector<std::thread> workers;
+			std::atomic<bool> running = true;
+			std::atomic<size_t> queued = 0;
+			std::atomic<size_t> sleeping = 0;
+			/// Changed by every queued and every finished job, parked workers and Wait() calls wait on it.
+			std::atomic<uint32_t> signal = 0;
+
+			inline static thread_local TinyVkJobSystem* workerSystem = nullptr;
+			inline static thread_local size_t workerIndex = 0;
+
+			/// <summary>Returns the deque of the calling thread (its own for workers, the injection deque otherwise).</summary>
+			size_t LocalDeque() const { return (workerSystem == this) ? workerIndex : workers.size(); }
+
+			void Push(const TinyVkJob& job, TinyVkJobCounter* counter) {
+				TinyVkJobDeque& local = *deques[LocalDeque()];
+				{
+					TinyVkLockGuard g(local.deque_lock);
+					local.entries.push_back({ job, counter });
+				}
+
+				queued.fetch_add(1);
+				Signal();
+			}
+
+			void Signal() {
+				signal.fetch_add(1);
+				if (sleeping.load() > 0) signal.notify_all();
+			}
+
+			/// <summary>Parks the calling thread until the signal changes, unless ready() (checked after registering as sleeping) is true.</summary>
+			template<typename F>
+			void Park(const F& ready) {
+				uint32_t current = signal.load();
+				sleeping.fetch_add(1);
+				if (!ready()) signal.wait(current);
+				sleeping.fetch_sub(1);
+			}
+
+			/// <summary>Pops the newest job of the local deque, else steals the oldest job of another deque.</summary>
+			bool Pop(TinyVkJobEntry& entry) {
+				if (queued.load(std::memory_order_relaxed) == 0) return false;
+
+				size_t local = LocalDeque();
+				{
+					TinyVkJobDeque& own = *deques[local];
+					TinyVkLockGuard g(own.deque_lock);
+					if (!own.entries.empty()) {
+						entry = own.entries.back();
+						own.entries.pop_back();
+						queued.fetch_sub(1);
+						return true;
+					}
+				}
+
+				for (size_t i = 1; i < deques.size(); i++) {
+					TinyVkJobDeque& victim = *deques[(local + i) % deques.size()];
+					TinyVkLockGuard g(victim.deque_lock);
+					if (!victim.entries.empty()) {
+						entry = victim.entries.front();
+						victim.entries.pop_front();
+						queued.fetch_sub(1);
+						return true;
+					}
+				}
+
+				return false;
+			}
+
+			void Execute(TinyVkJobEntry& entry) {
+				if (entry.counter == nullptr) {
+					entry.job();
+					return;
+				}
+
+				try {
+					entry.job();
+				} catch (...) {
+					TinyVkLockGuard g(entry.counter->counter_lock);
+					if (!entry.counter->error) entry.counter->error = std::current_exception();
+				}
+
+				Finish(*entry.counter);
+			}
+
+			/// <summary>Counts a finished job and queues the continuations of the counter once it reaches zero.</summary>
+			void Finish(TinyVkJobCounter& counter) {
+				std::vector<std::pair<TinyVkJob, TinyVkJobCounter*>> continuations;
+				{
+					// The counter may be destroyed by its waiter as soon as this lock is released.
+					TinyVkLockGuard g(counter.counter_lock);
+					if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+						continuations.swap(counter.continuations);
+				}
+
+				Signal();
+
+				for (auto& continuation : continuations)
+					Push(continuation.first, continuation.second);
+			}
+
+			void WorkerLoop(size_t index) {
+				workerSystem = this;
+				workerIndex = index;
+
+				TinyVkJobEntry entry;
+				while (running.load()) {
+					if (Pop(entry)) {
+						Execute(entry);
+						continue;
+					}
+
+					Park([this]() { return queued.load() > 0 || !running.load(); });
+				}
+			}
+
+		public:
+			TinyVkJobSystem(const TinyVkJobSystem&) = delete;
+			TinyVkJobSystem& operator=(const TinyVkJobSystem&) = delete;
+
+			/// <summary>Creates a job system with workerCount worker threads (0: hardware threads - 1, at least 1).</summary>
+			TinyVkJobSystem(size_t workerCount = 0) {
+				if (workerCount == 0)
+					workerCount = std::max(2U, std::thread::hardware_concurrency()) - 1U;
+
+				for (size_t i = 0; i <= workerCount; i++)
+					deques.push_back(std::make_unique<TinyVkJobDeque>());
+
+				for (size_t i = 0; i < workerCount; i++)
+					workers.push_back(std::thread([this, i]() { this->WorkerLoop(i); }));
+			}
+
+			/// <summary>Stops and joins the workers once every queued job has run.</summary>
+			~TinyVkJobSystem() {
+				TinyVkJobEntry entry;
+				while (Pop(entry)) Execute(entry);
+
+				running = false;
+				Signal();
+
+				for (std::thread& worker : workers)
+					if (worker.joinable()) worker.join();
+			}
+
+			/// <summary>Returns the shared job system used by the library (created on first use).</summary>
+			static TinyVkJobSystem& Default() {
+				static TinyVkJobSystem jobSystem;
+				return jobSystem;
+			}
+
+			/// <summary>Returns the number of worker threads.</summary>
+			size_t GetWorkerCount() const { return workers.size(); }
+
+			/// <summary>Returns true if the calling thread is a worker of this job system.</summary>
+			bool IsWorkerThread() const { return workerSystem == this; }
+
+			/// <summary>Queues a job (counted by counter if not nullptr).</summary>
+			void Run(const TinyVkJob& job, TinyVkJobCounter* counter = nullptr) {
+				if (counter != nullptr) counter->pending.fetch_add(1, std::memory_order_relaxed);
+				Push(job, counter);
+			}
+
+			/// <summary>Queues a job (counted by counter) once every job of dependency has finished.</summary>
+			void RunAfter(TinyVkJobCounter& dependency, const TinyVkJob& job, TinyVkJobCounter* counter = nullptr) {
+				if (counter != nullptr) counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+				{
+					TinyVkLockGuard g(dependency.counter_lock);
+					if (dependency.pending.load(std::memory_order_acquire) > 0) {
+						dependency.continuations.push_back({ job, counter });
+						return;
+					}
+				}
+
+				Push(job, counter);
+			}
+
+			/// <summary>Runs queued jobs until counter has at most target unfinished jobs, rethrows the first exception of its jobs.</summary>
+			void Wait(TinyVkJobCounter& counter, size_t target = 0) {
+				TinyVkJobEntry entry;
+
+				while (counter.Pending() > target) {
+					if (Pop(entry)) {
+						Execute(entry);
+						continue;
+					}
+
+					// Wakes for finished jobs and for queued jobs (which may be the jobs the counter waits on).
+					Park([&]() { return queued.load() > 0 || counter.Pending() <= target; });
+				}
+
+				// Synchronizes with the Finish() that released the counter (it no longer touches it).
+				TinyVkLockGuard g(counter.counter_lock);
+				if (counter.error) {
+					std::exception_ptr error = counter.error;
+					counter.error = nullptr;
+					std::rethrow_exception(error);
+				}
+			}
+
+			/// <summary>Runs task(index) for every index in [0, count) on up to threadCount threads (0: every worker) including the calling thread, waits for it and rethrows the first exception.</summary>
+			template<typename F>
+			void ParallelFor(size_t count, const F& task, size_t threadCount = 0) {
+				if (count == 0) return;
+
+				threadCount = std::min(count, (threadCount == 0) ? workers.size() + 1 : threadCount);
+				std::atomic<size_t> nextIndex = 0;
+				std::atomic<bool> failed = false;
+				TinyVkJobCounter counter;
+
+				auto lane = [&]() {
+					try {
+						for (size_t index = nextIndex++; index < count && !failed; index = nextIndex++)
+							task(index);
+					} catch (...) {
+						failed = true;
+						throw;
+					}
+				};
+
+				for (size_t i = 1; i < threadCount; i++)
+					Run([&lane]() { lane(); }, &counter);
+
+				std::exception_ptr error = nullptr;
+				try { lane(); } catch (...) { error = std::current_exception(); }
+
+				Wait(counter);
+				if (error) std::rethrow_exception(error);
+			}
+		};
+	}
+#endif
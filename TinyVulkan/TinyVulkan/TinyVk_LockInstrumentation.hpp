@@ -0,0 +1,167 @@
+#pragma once
+#ifndef TINYVK_TINYVKLOCKINSTRUMENTATION
+#define TINYVK_TINYVKLOCKINSTRUMENTATION
+	#include "./TinyVulkan.hpp"
+	#include <source_location>
+
+	#ifdef TINYVK_LOCK_INSTRUMENTATION
+	#include <array>
+	#include <atomic>
+	#include <bit>
+	#include <chrono>
+	#include <cstdlib>
+	#include <deque>
+	#include <iomanip>
+	#include <iostream>
+	#include <map>
+	#include <mutex>
+	#include <tuple>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			Define TINYVK_LOCK_INSTRUMENTATION (before including TinyVulkan) to record lock statistics per call site
+			(source file, line and function of each timed_guard/TinyVkLockGuard/TinyVkTryGuard): acquisitions,
+			contended acquisitions (the lock was taken), timeouts/failed try-locks, a log2 histogram of acquire wait
+			times and total/maximum wait and hold times.
+
+			TinyVkLockInstrumentation::GetStats() returns a copy of every site's statistics, Dump() prints them (most
+			waited-on sites first) and DumpAtExit() prints them to std::cerr when the program exits.
+			Without TINYVK_LOCK_INSTRUMENTATION the guards record nothing and cost nothing extra.
+		*/
+
+		constexpr size_t TinyVkLockHistogramBuckets = 32;
+
+		/// <summary>Copy of the lock statistics of one call site (times in nanoseconds).</summary>
+		struct TinyVkLockSiteStats {
+			std::string site;
+			uint64_t acquisitions = 0, contended = 0, timeouts = 0;
+			uint64_t waitTotal = 0, waitMax = 0, holdTotal = 0, holdMax = 0;
+			/// <summary>Acquire wait times: bucket 0 is 0ns, bucket b counts waits in [2^(b-1), 2^b) ns (the last bucket is open ended).</summary>
+			std::array<uint64_t, TinyVkLockHistogramBuckets> waitHistogram {};
+		};
+
+		/// <summary>Live lock statistics of one call site.</summary>
+		struct TinyVkLockSite {
+			std::string site;
+			std::atomic<uint64_t> acquisitions = 0, contended = 0, timeouts = 0;
+			std::atomic<uint64_t> waitTotal = 0, waitMax = 0, holdTotal = 0, holdMax = 0;
+			std::array<std::atomic<uint64_t>, TinyVkLockHistogramBuckets> waitHistogram {};
+
+			TinyVkLockSite(std::string site) : site(site) {}
+
+			static void StoreMax(std::atomic<uint64_t>& maximum, uint64_t value) {
+				uint64_t current = maximum.load(std::memory_order_relaxed);
+				while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed));
+			}
+
+			/// <summary>Records an acquire attempt that waited waitNanoseconds (wasContended if the lock was held, !acquired on timeout/failed try-lock).</summary>
+			void RecordAcquire(uint64_t waitNanoseconds, bool wasContended, bool acquired) {
+				if (wasContended) contended.fetch_add(1, std::memory_order_relaxed);
+				if (!acquired) { timeouts.fetch_add(1, std::memory_order_relaxed); return; }
+
+				acquisitions.fetch_add(1, std::memory_order_relaxed);
+				waitTotal.fetch_add(waitNanoseconds, std::memory_order_relaxed);
+				StoreMax(waitMax, waitNanoseconds);
+				waitHistogram[std::min<size_t>(std::bit_width(waitNanoseconds), TinyVkLockHistogramBuckets - 1)].fetch_add(1, std::memory_order_relaxed);
+			}
+
+			/// <summary>Records how long the lock was held.</summary>
+			void RecordRelease(uint64_t holdNanoseconds) {
+				holdTotal.fetch_add(holdNanoseconds, std::memory_order_relaxed);
+				StoreMax(holdMax, holdNanoseconds);
+			}
+
+			TinyVkLockSiteStats Snapshot() const {
+				TinyVkLockSiteStats stats;
+				stats.site = site;
+				stats.acquisitions = acquisitions.load(std::memory_order_relaxed);
+				stats.contended = contended.load(std::memory_order_relaxed);
+				stats.timeouts = timeouts.load(std::memory_order_relaxed);
+				stats.waitTotal = waitTotal.load(std::memory_order_relaxed);
+				stats.waitMax = waitMax.load(std::memory_order_relaxed);
+				stats.holdTotal = holdTotal.load(std::memory_order_relaxed);
+				stats.holdMax = holdMax.load(std::memory_order_relaxed);
+				for (size_t b = 0; b < TinyVkLockHistogramBuckets; b++) stats.waitHistogram[b] = waitHistogram[b].load(std::memory_order_relaxed);
+				return stats;
+			}
+		};
+
+		/// <summary>Registry of per call site lock statistics (TINYVK_LOCK_INSTRUMENTATION builds only).</summary>
+		class TinyVkLockInstrumentation {
+		private:
+			typedef std::tuple<const char*, uint_least32_t, uint_least32_t> TinyVkLockSiteKey;
+
+			inline static std::mutex registry_lock;
+			inline static std::deque<TinyVkLockSite> sites;
+			inline static std::map<std::string, TinyVkLockSite*> siteNames;
+			inline static std::atomic<bool> dumpAtExit = false;
+			inline static std::once_flag dumpAtExitOnce;
+			inline static thread_local std::map<TinyVkLockSiteKey, TinyVkLockSite*> siteCache;
+
+		public:
+			/// <summary>Returns the statistics of a call site (a per-thread cached lookup after its first use).</summary>
+			static TinyVkLockSite& GetSite(const std::source_location& location) {
+				TinyVkLockSiteKey key { location.file_name(), location.line(), location.column() };
+				auto cached = siteCache.find(key);
+				if (cached != siteCache.end()) return *cached->second;
+
+				std::string name = std::string(location.file_name()) + ":" + std::to_string(location.line()) + ":" + std::to_string(location.column()) + " " + location.function_name();
+				std::lock_guard<std::mutex> g(registry_lock);
+
+				auto named = siteNames.find(name);
+				TinyVkLockSite* site = (named != siteNames.end()) ? named->second : &sites.emplace_back(name);
+				siteNames[name] = site;
+				siteCache[key] = site;
+				return *site;
+			}
+
+			/// <summary>Returns a copy of the statistics of every call site that locked so far.</summary>
+			static std::vector<TinyVkLockSiteStats> GetStats() {
+				std::lock_guard<std::mutex> g(registry_lock);
+				std::vector<TinyVkLockSiteStats> stats;
+				for (const TinyVkLockSite& site : sites) stats.push_back(site.Snapshot());
+				return stats;
+			}
+
+			/// <summary>Resets the statistics of every call site.</summary>
+			static void Reset() {
+				std::lock_guard<std::mutex> g(registry_lock);
+				for (TinyVkLockSite& site : sites) {
+					site.acquisitions = 0; site.contended = 0; site.timeouts = 0;
+					site.waitTotal = 0; site.waitMax = 0; site.holdTotal = 0; site.holdMax = 0;
+					for (auto& bucket : site.waitHistogram) bucket = 0;
+				}
+			}
+
+			/// <summary>Prints the statistics of every call site, sorted by total wait time.</summary>
+			static void Dump(std::ostream& out) {
+				std::vector<TinyVkLockSiteStats> stats = GetStats();
+				std::sort(stats.begin(), stats.end(), [](const TinyVkLockSiteStats& a, const TinyVkLockSiteStats& b) { return a.waitTotal > b.waitTotal; });
+
+				out << "TinyVulkan: lock statistics (" << stats.size() << " sites, times in microseconds)\n";
+				for (const TinyVkLockSiteStats& site : stats) {
+					out << "  " << site.site << "\n" << std::fixed << std::setprecision(1)
+						<< "    acquired " << site.acquisitions << ", contended " << site.contended << ", timed out " << site.timeouts
+						<< " | wait avg " << ((site.acquisitions) ? site.waitTotal / 1000.0 / site.acquisitions : 0.0) << " max " << site.waitMax / 1000.0
+						<< " | hold avg " << ((site.acquisitions) ? site.holdTotal / 1000.0 / site.acquisitions : 0.0) << " max " << site.holdMax / 1000.0 << "\n    wait histogram:";
+
+					for (size_t b = 0; b < TinyVkLockHistogramBuckets; b++)
+						if (site.waitHistogram[b] != 0) out << " <" << (1ULL << b) << "ns:" << site.waitHistogram[b];
+					out << "\n";
+				}
+			}
+
+			/// <summary>Prints the statistics to std::cerr when the program exits.</summary>
+			static void DumpAtExit(bool enable = true) {
+				dumpAtExit = enable;
+				std::call_once(dumpAtExitOnce, []() { std::atexit([]() { if (dumpAtExit) Dump(std::cerr); }); });
+			}
+
+			/// <summary>Returns nanoseconds between two steady_clock time points.</summary>
+			static uint64_t Nanoseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+			}
+		};
+	}
+	#endif
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef TINYVK_TINYVKMAPPEDFILE
+#define TINYVK_TINYVKMAPPEDFILE
+	#include "./TinyVulkan.hpp"
+	#if defined (_WIN32)
+		#ifndef NOMINMAX
+			#define NOMINMAX
+		#endif
+		#include <windows.h>
+	#else
+		#include <fcntl.h>
+		#include <sys/mman.h>
+		#include <sys/stat.h>
+		#include <unistd.h>
+	#endif
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkMappedFile maps a file read-only into memory (mmap on Linux/POSIX, MapViewOfFile on Windows), so
+			shader modules and QOI images are created/decoded directly from the page cache instead of first copying every
+			file through an ifstream/fread heap buffer.
+
+			The mapped bytes are valid until the TinyVkMappedFile is disposed. Empty files map to GetData() == nullptr.
+		*/
+
+		/// <summary>Read-only memory-mapped file for loading shaders and image assets without heap copies.</summary>
+		class TinyVkMappedFile : public TinyVkDisposable {
+		private:
+			const uint8_t* data = nullptr;
+			size_t size = 0;
+			std::string path;
+
+			#if defined (_WIN32)
+			HANDLE fileHandle = INVALID_HANDLE_VALUE;
+			HANDLE mappingHandle = nullptr;
+			#else
+			int fileDescriptor = -1;
+			#endif
+
+			void MapFile() {
+				#if defined (_WIN32)
+				fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+				LARGE_INTEGER fileSize;
+				if (fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(fileHandle, &fileSize))
+					throw std::runtime_error("TinyVulkan: Failed to Read File: " + path);
+
+				size = static_cast<size_t>(fileSize.QuadPart);
+				if (size == 0) return;
+
+				mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mappingHandle != nullptr)
+					data = static_cast<const uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+				#else
+				fileDescriptor = open(path.c_str(), O_RDONLY);
+				struct stat fileStat;
+				if (fileDescriptor < 0 || fstat(fileDescriptor, &fileStat) != 0)
+					throw std::runtime_error("TinyVulkan: Failed to Read File: " + path);
+
+				size = static_cast<size_t>(fileStat.st_size);
+				if (size == 0) return;
+
+				void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+				if (mapping != MAP_FAILED) data = static_cast<const uint8_t*>(mapping);
+				#endif
+
+				if (data == nullptr)
+					throw std::runtime_error("TinyVulkan: Failed to memory-map File: " + path);
+			}
+
+		public:
+			~TinyVkMappedFile() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				#if defined (_WIN32)
+				if (data != nullptr) UnmapViewOfFile(data);
+				if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+				if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+				mappingHandle = nullptr;
+				fileHandle = INVALID_HANDLE_VALUE;
+				#else
+				if (data != nullptr) munmap(const_cast<uint8_t*>(data), size);
+				if (fileDescriptor >= 0) close(fileDescriptor);
+				fileDescriptor = -1;
+				#endif
+
+				data = nullptr;
+				size = 0;
+			}
+
+			/// <summary>Memory-maps the file at path for reading (throws if the file cannot be opened or mapped).</summary>
+			TinyVkMappedFile(const std::string& path) : path(path) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				try {
+					MapFile();
+				} catch (...) {
+					Disposable(false);
+					throw;
+				}
+			}
+
+			TinyVkMappedFile operator=(const TinyVkMappedFile& mappedFile) = delete;
+
+			/// <summary>Returns the mapped bytes of the file (nullptr for empty files).</summary>
+			const uint8_t* GetData() { return data; }
+
+			/// <summary>Returns the size of the mapped file in bytes.</summary>
+			size_t GetSize() { return size; }
+
+			/// <summary>Returns the path of the mapped file.</summary>
+			const std::string& GetPath() { return path; }
+
+			/// <summary>Hints the OS to read the mapped file ahead of use (e.g. before decoding on a worker thread).</summary>
+			void Prefetch() {
+				if (data == nullptr) return;
+
+				#if defined (_WIN32)
+				WIN32_MEMORY_RANGE_ENTRY range { const_cast<uint8_t*>(data), size };
+				PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+				#else
+				madvise(const_cast<uint8_t*>(data), size, MADV_WILLNEED);
+				#endif
+			}
+		};
+	}
+
+#endif
@@ -0,0 +1,194 @@
+#pragma once
+#ifndef TINYVK_TINYVKRENDERTHREAD
+#define TINYVK_TINYVKRENDERTHREAD
+	#include "./TinyVulkan.hpp"
+	#include <array>
+	#include <atomic>
+	#include <thread>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			Game thread / render thread split: the game thread simulates and describes each frame as a frame packet T
+			(draw lists, camera/constants, etc.), the render thread records and presents frames from those packets only,
+			so simulation of frame N+1 overlaps recording of frame N without sharing (or locking) scene state.
+
+			TinyVkFramePacketQueue<T, N> is a bounded single-producer/single-consumer queue of N preallocated packets:
+				Game thread:	BeginPacket() -> fill the packet -> SubmitPacket(). BeginPacket() waits while the render
+								thread is N - 1 packets behind (the game thread never runs more than N - 1 frames ahead).
+				Render thread:	NextPacket() takes the next submitted packet (FIFO), or keeps the packet it already holds if
+								none was submitted (re-renders it, e.g. while the game thread is paused by a window drag).
+								The held packet is immutable until the render thread takes the next one.
+			Packets are reused round robin: BeginPacket() returns the packet submitted N frames ago, so clear() and refill
+			its containers (their capacity is kept, so steady-state frames do not allocate).
+
+			TinyVkRenderThread<T, N> runs TinyVkSwapChainRenderer::RenderExecute() on its own thread with the packet of each
+			frame passed to onRenderPacket(packet, commandPool) (instead of onRenderEvents). It stops when the window
+			closes, on Stop() or on Dispose() (it is owned by the swap chain renderer, which disposes it first), and closes
+			the queue so a waiting BeginPacket() returns nullptr. Use queued window event dispatch (TINYVK_EVENT_DISPATCH_QUEUED)
+			and call TinyVkWindow::DispatchEvents() from onBeginFrame so resizes also render on the render thread.
+		*/
+
+		/// <summary>Bounded SPSC queue of N reused frame packets from a game (producer) thread to the render (consumer) thread.</summary>
+		template<typename T, size_t N = 3>
+		class TinyVkFramePacketQueue {
+			static_assert(N >= 2, "TinyVulkan: TinyVkFramePacketQueue requires at least 2 packets!");
+
+		private:
+			std::array<T, N> packets {};
+			/// Number of submitted packets.
+			std::atomic<uint64_t> written = 0;
+			/// Number of packets taken by the consumer.
+			std::atomic<uint64_t> read = 0;
+			/// Oldest packet the consumer still holds (the producer may not write it or any later packet).
+			std::atomic<uint64_t> retained = 0;
+			std::atomic<bool> closed = false;
+			std::atomic<uint32_t> signal = 0;
+
+			void Signal() {
+				signal.fetch_add(1);
+				signal.notify_all();
+			}
+
+		public:
+			TinyVkFramePacketQueue() = default;
+			TinyVkFramePacketQueue(const TinyVkFramePacketQueue&) = delete;
+			TinyVkFramePacketQueue& operator=(const TinyVkFramePacketQueue&) = delete;
+
+			/// <summary>[game thread] Returns the next packet to fill, waits while N - 1 packets are queued (nullptr once the queue is closed).</summary>
+			T* BeginPacket() {
+				while (true) {
+					uint32_t current = signal.load();
+					if (closed.load()) return nullptr;
+
+					uint64_t index = written.load(std::memory_order_relaxed);
+					if (index - retained.load(std::memory_order_acquire) < N) return &packets[index % N];
+					signal.wait(current);
+				}
+			}
+
+			/// <summary>[game thread] Submits the packet returned by BeginPacket() to the render thread.</summary>
+			void SubmitPacket() {
+				written.fetch_add(1, std::memory_order_release);
+				Signal();
+			}
+
+			/// <summary>[render thread] Takes the next submitted packet, else returns the packet already held (nullptr if none was ever submitted).</summary>
+			const T* NextPacket() {
+				uint64_t index = read.load(std::memory_order_relaxed);
+
+				if (index < written.load(std::memory_order_acquire)) {
+					read.store(index + 1, std::memory_order_relaxed);
+					retained.store(index, std::memory_order_release);
+					Signal();
+					return &packets[index % N];
+				}
+
+				return (index > 0) ? &packets[(index - 1) % N] : nullptr;
+			}
+
+			/// <summary>[render thread] Waits for and takes the next submitted packet (nullptr once the queue is closed).</summary>
+			const T* WaitPacket() {
+				while (true) {
+					uint32_t current = signal.load();
+					if (read.load(std::memory_order_relaxed) < written.load(std::memory_order_acquire)) return NextPacket();
+					if (closed.load()) return nullptr;
+					signal.wait(current);
+				}
+			}
+
+			/// <summary>Closes the queue: waiting BeginPacket()/WaitPacket() calls return nullptr.</summary>
+			void Close() {
+				closed = true;
+				Signal();
+			}
+
+			/// <summary>Returns true if the queue was closed.</summary>
+			bool IsClosed() const { return closed.load(); }
+
+			/// <summary>Returns the number of submitted packets the render thread has not taken yet.</summary>
+			size_t GetQueuedCount() const { return static_cast<size_t>(written.load() - read.load()); }
+		};
+
+		/// <summary>Render thread which renders frame packets submitted by the game thread to a TinyVkSwapChainRenderer.</summary>
+		template<typename T, size_t N = 3>
+		class TinyVkRenderThread : public TinyVkDisposable {
+		private:
+			TinyVkSwapChainRenderer& swapRenderer;
+			TinyVkFramePacketQueue<T, N> packets;
+			TinyVkCallback<TinyVkCommandPool&> renderCallback;
+			std::atomic<const T*> currentPacket = nullptr;
+			std::atomic<bool> running = false;
+			std::thread renderThread;
+
+			void RenderLoop() {
+				while (running && !swapRenderer.window.ShouldClose()) {
+					const T* packet = packets.NextPacket();
+					if (packet == nullptr && (packet = packets.WaitPacket()) == nullptr) break;
+
+					currentPacket = packet;
+					onBeginFrame.invoke();
+					swapRenderer.RenderExecute();
+					currentPacket = nullptr;
+				}
+
+				packets.Close();
+			}
+
+		public:
+			/// Invokable Frame Events: (executed on the render thread before each frame with its packet current, outside of the swap chain lock)
+			TinyVkInvokable<> onBeginFrame;
+			/// Invokable Render Events: (executed on the render thread in TinyVkSwapChainRenderer::RenderExecute() with the frame's packet)
+			TinyVkInvokable<const T&, TinyVkCommandPool&> onRenderPacket;
+
+			TinyVkRenderThread(const TinyVkRenderThread&) = delete;
+			TinyVkRenderThread& operator=(const TinyVkRenderThread&) = delete;
+
+			~TinyVkRenderThread() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				Stop();
+				swapRenderer.onRenderEvents.unhook(renderCallback);
+			}
+
+			/// <summary>Creates a (stopped) render thread for the swap chain renderer, call Start() to begin rendering.</summary>
+			TinyVkRenderThread(TinyVkSwapChainRenderer& swapRenderer) : swapRenderer(swapRenderer) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				renderCallback = TinyVkCallback<TinyVkCommandPool&>([this](TinyVkCommandPool& commandPool) {
+					const T* packet = this->currentPacket.load();
+					if (packet != nullptr) this->onRenderPacket.invoke(*packet, commandPool);
+				});
+
+				swapRenderer.onRenderEvents.hook(renderCallback);
+				SetOwner(swapRenderer);
+			}
+
+			/// <summary>Starts the render thread (it renders once the first packet is submitted).</summary>
+			void Start() {
+				if (running.exchange(true)) return;
+				renderThread = std::thread([this]() { this->RenderLoop(); });
+			}
+
+			/// <summary>Stops and joins the render thread, closing the packet queue.</summary>
+			void Stop() {
+				running = false;
+				packets.Close();
+
+				if (renderThread.joinable())
+					renderThread.join();
+			}
+
+			/// <summary>Returns true until the render thread stopped (window closed, Stop() or Dispose()).</summary>
+			bool IsRunning() const { return running && !packets.IsClosed(); }
+
+			/// <summary>[game thread] Returns the next packet to fill (waits while the render thread is N - 1 packets behind), nullptr once stopped.</summary>
+			T* BeginPacket() { return packets.BeginPacket(); }
+
+			/// <summary>[game thread] Submits the packet returned by BeginPacket() for rendering.</summary>
+			void SubmitPacket() { packets.SubmitPacket(); }
+
+			/// <summary>Returns the frame packet queue.</summary>
+			TinyVkFramePacketQueue<T, N>& GetPacketQueue() { return packets; }
+		};
+	}
+#endif
@@ -0,0 +1,171 @@
+#pragma once
+#ifndef TINYVK_TINYVKSAMPLERCACHE
+#define TINYVK_TINYVKSAMPLERCACHE
+	#include "./TinyVulkan.hpp"
+	#include <array>
+	#include <bit>
+	#include <unordered_map>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkSamplerCache shares VkSamplers between every TinyVkImage (and any other user) of a TinyVkVulkanDevice,
+			since nearly all images sample with identical parameters and drivers limit the number of live samplers
+			(maxSamplerAllocationCount, as low as 4000) far below the number of images an application can hold.
+
+			Samplers are keyed by the contents of their VkSamplerCreateInfo (pNext chains are not supported). Acquire()
+			returns the shared sampler and adds a reference, Release() drops it. Unreferenced samplers stay cached so
+			streamed images do not re-create them, Trim() destroys them through the device TinyVkDeletionQueue (after
+			any in-flight submission that may still sample with them has been retired).
+
+			Samplers do not depend on an image's mip count: CreateInfo() uses VK_LOD_CLAMP_NONE for maxLod, the image
+			view already limits sampling to its mip levels, so images of any size share the same sampler.
+		*/
+
+		/// <summary>Device-level cache of reference counted VkSamplers keyed by their VkSamplerCreateInfo.</summary>
+		class TinyVkSamplerCache {
+		private:
+			typedef std::array<uint32_t, 16> TinyVkSamplerKey;
+
+			struct TinyVkSamplerKeyHash {
+				size_t operator()(const TinyVkSamplerKey& key) const {
+					size_t hash = 14695981039346656037ULL;
+					for (uint32_t word : key) hash = (hash ^ word) * 1099511628211ULL;
+					return hash;
+				}
+			};
+
+			struct TinyVkSamplerEntry {
+				VkSampler sampler;
+				uint32_t references;
+			};
+
+			std::timed_mutex cache_lock;
+			VkDevice& logicalDevice;
+			TinyVkDeletionQueue& deletionQueue;
+			std::unordered_map<TinyVkSamplerKey, TinyVkSamplerEntry, TinyVkSamplerKeyHash> samplers;
+			std::unordered_map<VkSampler, TinyVkSamplerKey> keys;
+
+			/// <summary>Returns the cache key of every field of a VkSamplerCreateInfo that affects sampling.</summary>
+			static TinyVkSamplerKey GetKey(const VkSamplerCreateInfo& info) {
+				return {
+					static_cast<uint32_t>(info.flags), static_cast<uint32_t>(info.magFilter), static_cast<uint32_t>(info.minFilter), static_cast<uint32_t>(info.mipmapMode),
+					static_cast<uint32_t>(info.addressModeU), static_cast<uint32_t>(info.addressModeV), static_cast<uint32_t>(info.addressModeW),
+					std::bit_cast<uint32_t>(info.mipLodBias), info.anisotropyEnable, std::bit_cast<uint32_t>((info.anisotropyEnable) ? info.maxAnisotropy : 1.0f),
+					info.compareEnable, static_cast<uint32_t>((info.compareEnable) ? info.compareOp : VK_COMPARE_OP_NEVER),
+					std::bit_cast<uint32_t>(info.minLod), std::bit_cast<uint32_t>(info.maxLod), static_cast<uint32_t>(info.borderColor), info.unnormalizedCoordinates
+				};
+			}
+
+		public:
+			TinyVkSamplerCache operator=(const TinyVkSamplerCache&) = delete;
+
+			/// <summary>Creates a sampler cache for the logical device (the handle is read on use, so it may be created later).</summary>
+			TinyVkSamplerCache(VkDevice& logicalDevice, TinyVkDeletionQueue& deletionQueue) : logicalDevice(logicalDevice), deletionQueue(deletionQueue) {}
+
+			/// <summary>Returns a VkSamplerCreateInfo for linear (or nearest) filtering with the same addressing mode on every axis.</summary>
+			static VkSamplerCreateInfo CreateInfo(VkSamplerAddressMode addressingMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VkFilter filter = VK_FILTER_LINEAR) {
+				VkSamplerCreateInfo samplerInfo {};
+				samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+				samplerInfo.magFilter = filter;
+				samplerInfo.minFilter = filter;
+				samplerInfo.addressModeU = addressingMode;
+				samplerInfo.addressModeV = addressingMode;
+				samplerInfo.addressModeW = addressingMode;
+				samplerInfo.anisotropyEnable = VK_FALSE;
+				samplerInfo.maxAnisotropy = 1.0f;
+				samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+				samplerInfo.unnormalizedCoordinates = VK_FALSE;
+				samplerInfo.compareEnable = VK_FALSE;
+				samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+				samplerInfo.mipmapMode = (filter == VK_FILTER_NEAREST) ? VK_SAMPLER_MIPMAP_MODE_NEAREST : VK_SAMPLER_MIPMAP_MODE_LINEAR;
+				samplerInfo.mipLodBias = 0.0f;
+				samplerInfo.minLod = 0.0f;
+				samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+				return samplerInfo;
+			}
+
+			/// <summary>Returns the shared sampler for the create info (creating it on first use) and adds a reference to it.</summary>
+			VkSampler Acquire(const VkSamplerCreateInfo& info) {
+				if (info.pNext != nullptr)
+					throw std::runtime_error("TinyVulkan: TinyVkSamplerCache does not support VkSamplerCreateInfo pNext chains!");
+
+				TinyVkSamplerKey key = GetKey(info);
+				timed_guard<false> g(cache_lock);
+
+				auto cached = samplers.find(key);
+				if (cached != samplers.end()) {
+					cached->second.references++;
+					return cached->second.sampler;
+				}
+
+				VkSampler sampler;
+				if (vkCreateSampler(logicalDevice, &info, nullptr, &sampler) != VK_SUCCESS)
+					throw std::runtime_error("TinyVulkan: Failed to create image texture sampler!");
+
+				samplers[key] = { sampler, 1 };
+				keys[sampler] = key;
+				return sampler;
+			}
+
+			/// <summary>Drops a reference to a sampler returned by Acquire() (samplers the cache does not own are ignored), unreferenced samplers stay cached until Trim().</summary>
+			void Release(VkSampler sampler) {
+				if (sampler == VK_NULL_HANDLE) return;
+
+				timed_guard<false> g(cache_lock);
+				auto key = keys.find(sampler);
+				if (key == keys.end()) return;
+
+				TinyVkSamplerEntry& entry = samplers[key->second];
+				if (entry.references > 0) entry.references--;
+			}
+
+			/// <summary>Destroys every unreferenced sampler (deferred until in-flight submissions are retired). Returns the number of samplers trimmed.</summary>
+			size_t Trim() {
+				std::vector<VkSampler> unreferenced;
+				timed_guard<false> g(cache_lock);
+
+				for (auto entry = samplers.begin(); entry != samplers.end();) {
+					if (entry->second.references == 0) {
+						unreferenced.push_back(entry->second.sampler);
+						keys.erase(entry->second.sampler);
+						entry = samplers.erase(entry);
+					} else entry++;
+				}
+
+				g.Unlock();
+				VkDevice device = logicalDevice;
+				if (!unreferenced.empty())
+					deletionQueue.Enqueue([device, unreferenced]() {
+						for (VkSampler sampler : unreferenced) vkDestroySampler(device, sampler, nullptr);
+					});
+
+				return unreferenced.size();
+			}
+
+			/// <summary>Destroys every cached sampler immediately (on device disposal, after the GPU is idle).</summary>
+			void Flush() {
+				timed_guard<false> g(cache_lock);
+				for (auto& entry : samplers) vkDestroySampler(logicalDevice, entry.second.sampler, nullptr);
+				samplers.clear();
+				keys.clear();
+			}
+
+			/// <summary>Returns the number of cached (referenced and unreferenced) samplers.</summary>
+			size_t GetSamplerCount() {
+				timed_guard<false> g(cache_lock);
+				return samplers.size();
+			}
+
+			/// <summary>Returns the number of references to a cached sampler (0 if it is unreferenced or not cached).</summary>
+			uint32_t GetReferenceCount(VkSampler sampler) {
+				timed_guard<false> g(cache_lock);
+				auto key = keys.find(sampler);
+				return (key != keys.end()) ? samplers[key->second].references : 0;
+			}
+
+			/// <summary>Creates the data descriptor of a standalone sampler (VK_DESCRIPTOR_TYPE_SAMPLER) for graphicspipeline.SelectWrite*Descriptor().</summary>
+			static VkDescriptorImageInfo GetSamplerDescriptor(VkSampler sampler) { return { sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED }; }
+		};
+	}
+
+#endif
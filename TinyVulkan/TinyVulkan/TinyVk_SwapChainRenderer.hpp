@@ -27,9 +27,9 @@
 		/// 
 		
 		/// <summary>Onscreen Rendering (Render/Present-To-Screen Model): Render to SwapChain.</summary>
-		class TinyVkSwapChainRenderer : public TinyVkRendererInterface, TinyVkDisposable {
+		class TinyVkSwapChainRenderer : public TinyVkRendererInterface, public TinyVkDisposable {
 		private:
-			std::timed_mutex swapChainMutex;
+			TinyVkSpinMutex swapChainMutex;
 			TinyVkSurfaceSupporter presentDetails;
 			VkSwapchainKHR swapChain = nullptr;
 			VkFormat imageFormat;
@@ -227,6 +227,7 @@
 
 			VkResult RendererAcquireImage() {
 				vkWaitForFences(vkdevice.logicalDevice, 1, &inFlightFences[currentSyncFrame], VK_TRUE, UINT64_MAX);
+				vkdevice.deletionQueue.Collect();
 				VkResult result = AcquireNextImage(imageAvailableSemaphores[currentSyncFrame], VK_NULL_HANDLE, currentSwapFrame);
 				vkResetFences(vkdevice.logicalDevice, 1, &inFlightFences[currentSyncFrame]);
 				return result;
@@ -238,7 +239,7 @@
 				if (graphicsPipeline.DepthTestingIsEnabled()) {
 					TinyVkImage* depthImage = optionalDepthImages[currentSyncFrame];
 					if (depthImage->width != imageExtent.width || depthImage->height != imageExtent.height) {
-						depthImage->Disposable(false);
+						depthImage->Disposable(true);
 						depthImage->ReCreateImage(imageExtent.width, imageExtent.height, depthImage->isDepthImage, graphicsPipeline.QueryDepthFormat(), TINYVK_DEPTHSTENCIL_ATTACHMENT_OPTIMAL, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_IMAGE_ASPECT_DEPTH_BIT);
 					}
 				}
@@ -274,6 +275,8 @@
 				if (vkQueueSubmit(graphicsPipeline.GetGraphicsQueue(), 1, &submitInfo, inFlightFences[currentSyncFrame]) != VK_SUCCESS)
 					throw std::runtime_error("TinyVulkan: Failed to submit draw command buffer!");
 
+				vkdevice.deletionQueue.SignalSubmission(inFlightFences[currentSyncFrame]);
+
 				VkPresentInfoKHR presentInfo{};
 				presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 				presentInfo.waitSemaphoreCount = 1;
@@ -319,24 +322,29 @@
 			~TinyVkSwapChainRenderer() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
-				if (waitIdle) vkdevice.DeviceWaitIdle();
+				if (waitIdle) {
+					// Only wait on this renderer's own frames (presentation has no fence, so wait on the present queue).
+					vkWaitForFences(vkdevice.logicalDevice, static_cast<uint32_t>(inFlightFences.size()), inFlightFences.data(), VK_TRUE, UINT64_MAX);
+					vkQueueWaitIdle(graphicsPipeline.GetPresentQueue());
+				}
 
 				if (graphicsPipeline.DepthTestingIsEnabled()) {
 					for(size_t i = 0; i < static_cast<size_t>(bufferingMode); i++) {
-						optionalDepthImages[i]->Dispose();
+						optionalDepthImages[i]->Dispose(waitIdle);
 						delete optionalDepthImages[i];
 					}
 
-					depthImagePool->Dispose();
+					depthImagePool->Dispose(waitIdle);
 					delete depthImagePool;
 				}
 
 				for (TinyVkCommandPool* cmdPool : commandPools) {
-					cmdPool->Dispose();
+					cmdPool->Dispose(waitIdle);
 					delete cmdPool;
 				}
 
 				for (size_t i = 0; i < inFlightFences.size(); i++) {
+					vkdevice.deletionQueue.RetireFence(inFlightFences[i]);
 					vkDestroySemaphore(vkdevice.logicalDevice, imageAvailableSemaphores[i], nullptr);
 					vkDestroySemaphore(vkdevice.logicalDevice, renderFinishedSemaphores[i], nullptr);
 					vkDestroyFence(vkdevice.logicalDevice, inFlightFences[i], nullptr);
@@ -369,6 +377,8 @@
 
 				CreateSwapChain();
 				CreateImageSyncObjects();
+
+				SetOwner(vkdevice);
 			}
 
 			/// <summary>Acquires the next image from the swap chain and returns out that image index.</summary>
@@ -381,8 +391,7 @@
 				if (hwndWindow != window.GetHandle()) return;
 
 				if (width > 0 && height > 0) {
-					timed_guard<false> swapChainLock(swapChainMutex);
-					if (!swapChainLock.Acquired()) return;
+					TinyVkLockGuard swapChainLock(swapChainMutex);
 
 					vkDeviceWaitIdle(vkdevice.GetLogicalDevice());
 
@@ -398,6 +407,9 @@
 				}
 			}
 
+			/// <summary>Returns how many times rendering and swap chain resizing had to wait on each other.</summary>
+			uint64_t GetSwapChainLockContention() const { return swapChainMutex.GetContentionCount(); }
+
 			/// <summary>Returns the current resource synchronized frame index.</summary>
 			size_t GetSyncronizedFrameIndex() { return currentSyncFrame; }
 
@@ -551,8 +563,7 @@
 
 			/// <summary>Executes the registered onRenderEvents and presents them to the SwapChain(Window).</summary>
 			void RenderExecute() {
-				timed_guard swapChainLock(swapChainMutex);
-				if (!swapChainLock.Acquired()) return;
+				TinyVkLockGuard swapChainLock(swapChainMutex);
 				RenderSwapChain();
 			}
 		};
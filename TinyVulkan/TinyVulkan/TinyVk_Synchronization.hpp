@@ -0,0 +1,227 @@
+#pragma once
+#ifndef TINYVK_TINYVKSYNCHRONIZATION
+#define TINYVK_TINYVKSYNCHRONIZATION
+	#include "./TinyVulkan.hpp"
+	#include <array>
+	#include <atomic>
+	#include <cstring>
+	#include <thread>
+	#include <type_traits>
+	#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+		#include <immintrin.h>
+		#define TINYVK_CPU_RELAX() _mm_pause()
+	#else
+		#define TINYVK_CPU_RELAX() std::this_thread::yield()
+	#endif
+
+	#ifndef TINYVK_SPIN_COUNT
+		#define TINYVK_SPIN_COUNT 128
+	#endif
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			Synchronization for per-frame (hot) paths where std::timed_mutex/timed_guard cost far more than needed:
+
+			TinyVkSpinMutex: uncontended lock()/unlock() are a single atomic op each. Contended lock() spins
+				TINYVK_SPIN_COUNT times (critical sections here are short), then parks on the atomic (C++20 wait/notify)
+				instead of burning CPU. Each contended lock() is counted (GetContentionCount()).
+			TinyVkLockGuard / TinyVkTryGuard: scoped lock()/try_lock() (no timers) with Acquired() and early Unlock().
+			TinyVkSeqLock<T>: read-mostly trivially copyable state: Load() never blocks writers and retries only if it
+				overlapped a Store(), data is held in relaxed atomic words so readers and writers never race.
+		*/
+
+		/// <summary>Spin-then-park mutex (0 = unlocked, 1 = locked, 2 = locked with parked waiters).</summary>
+		class TinyVkSpinMutex {
+		private:
+			std::atomic<uint32_t> state = 0;
+			std::atomic<uint64_t> contentions = 0;
+
+		public:
+			TinyVkSpinMutex() = default;
+			TinyVkSpinMutex(const TinyVkSpinMutex&) = delete;
+			TinyVkSpinMutex& operator=(const TinyVkSpinMutex&) = delete;
+
+			/// <summary>Locks the mutex if it is unlocked, returns true if locked (never waits).</summary>
+			bool try_lock() noexcept {
+				uint32_t unlocked = 0;
+				return state.compare_exchange_strong(unlocked, 1, std::memory_order_acquire, std::memory_order_relaxed);
+			}
+
+			/// <summary>Locks the mutex, spinning briefly then parking the thread while it is contended.</summary>
+			void lock() noexcept {
+				if (try_lock()) return;
+				contentions.fetch_add(1, std::memory_order_relaxed);
+
+				for (uint32_t spin = 0; spin < TINYVK_SPIN_COUNT; spin++) {
+					TINYVK_CPU_RELAX();
+					if (state.load(std::memory_order_relaxed) == 0 && try_lock()) return;
+				}
+
+				// Mark the mutex as having parked waiters so unlock() knows to wake one.
+				while (state.exchange(2, std::memory_order_acquire) != 0)
+					state.wait(2, std::memory_order_relaxed);
+			}
+
+			/// <summary>Unlocks the mutex, waking a parked waiter if there is one.</summary>
+			void unlock() noexcept {
+				if (state.exchange(0, std::memory_order_release) == 2)
+					state.notify_one();
+			}
+
+			/// <summary>Returns the number of lock() calls that found the mutex locked.</summary>
+			uint64_t GetContentionCount() const noexcept { return contentions.load(std::memory_order_relaxed); }
+		};
+
+		/// <summary>Scoped lock() of a mutex with early Unlock().</summary>
+		template<typename M>
+		class _NODISCARD_LOCK TinyVkLockGuard {
+		private:
+			M& lock;
+			bool signal;
+			#ifdef TINYVK_LOCK_INSTRUMENTATION
+			TinyVkLockSite& site;
+			std::chrono::steady_clock::time_point acquired;
+			#endif
+
+		public:
+			#ifdef TINYVK_LOCK_INSTRUMENTATION
+			explicit TinyVkLockGuard(M& lock, const std::source_location location = std::source_location::current())
+				: lock(lock), signal(true), site(TinyVkLockInstrumentation::GetSite(location)) {
+				auto start = std::chrono::steady_clock::now();
+				bool contended = !lock.try_lock();
+				if (contended) lock.lock();
+
+				acquired = std::chrono::steady_clock::now();
+				site.RecordAcquire(TinyVkLockInstrumentation::Nanoseconds(start, acquired), contended, true);
+			}
+			#else
+			explicit TinyVkLockGuard(M& lock) : lock(lock), signal(true) { lock.lock(); }
+			#endif
+			~TinyVkLockGuard() noexcept { Unlock(); }
+
+			TinyVkLockGuard(const TinyVkLockGuard&) = delete;
+			TinyVkLockGuard& operator=(const TinyVkLockGuard&) = delete;
+
+			bool Acquired() const { return signal; }
+			void Unlock() {
+				if (!signal) return;
+				#ifdef TINYVK_LOCK_INSTRUMENTATION
+				site.RecordRelease(TinyVkLockInstrumentation::Nanoseconds(acquired, std::chrono::steady_clock::now()));
+				#endif
+				lock.unlock();
+				signal = false;
+			}
+		};
+
+		/// <summary>Scoped try_lock() of a mutex (no timer), check Acquired() before using the guarded state.</summary>
+		template<typename M>
+		class _NODISCARD_LOCK TinyVkTryGuard {
+		private:
+			M& lock;
+			bool signal;
+			#ifdef TINYVK_LOCK_INSTRUMENTATION
+			TinyVkLockSite& site;
+			std::chrono::steady_clock::time_point acquired;
+			#endif
+
+		public:
+			#ifdef TINYVK_LOCK_INSTRUMENTATION
+			explicit TinyVkTryGuard(M& lock, const std::source_location location = std::source_location::current())
+				: lock(lock), signal(lock.try_lock()), site(TinyVkLockInstrumentation::GetSite(location)) {
+				acquired = std::chrono::steady_clock::now();
+				site.RecordAcquire(0, !signal, signal);
+			}
+			#else
+			explicit TinyVkTryGuard(M& lock) : lock(lock), signal(lock.try_lock()) {}
+			#endif
+			~TinyVkTryGuard() noexcept { Unlock(); }
+
+			TinyVkTryGuard(const TinyVkTryGuard&) = delete;
+			TinyVkTryGuard& operator=(const TinyVkTryGuard&) = delete;
+
+			bool Acquired() const { return signal; }
+			void Unlock() {
+				if (!signal) return;
+				#ifdef TINYVK_LOCK_INSTRUMENTATION
+				site.RecordRelease(TinyVkLockInstrumentation::Nanoseconds(acquired, std::chrono::steady_clock::now()));
+				#endif
+				lock.unlock();
+				signal = false;
+			}
+		};
+
+		/// <summary>Sequence lock for read-mostly trivially copyable state: wait-free for writers against readers, readers retry on overlap.</summary>
+		template<typename T>
+		class TinyVkSeqLock {
+			static_assert(std::is_trivially_copyable_v<T>, "TinyVulkan: TinyVkSeqLock state must be trivially copyable!");
+
+		private:
+			static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+			TinyVkSpinMutex write_lock;
+			std::atomic<uint64_t> sequence = 0;
+			std::array<std::atomic<uint64_t>, WordCount> words {};
+
+			/// <summary>Writes the state words (call with the write_lock held).</summary>
+			void Write(const T& value) {
+				uint64_t buffer[WordCount] {};
+				std::memcpy(buffer, &value, sizeof(T));
+
+				uint64_t start = sequence.load(std::memory_order_relaxed);
+				sequence.store(start + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+
+				for (size_t w = 0; w < WordCount; w++) words[w].store(buffer[w], std::memory_order_relaxed);
+				sequence.store(start + 2, std::memory_order_release);
+			}
+
+			/// <summary>Reads the state words without checking the sequence (call with the write_lock held).</summary>
+			T ReadLocked() const {
+				uint64_t buffer[WordCount];
+				for (size_t w = 0; w < WordCount; w++) buffer[w] = words[w].load(std::memory_order_relaxed);
+
+				T value;
+				std::memcpy(&value, buffer, sizeof(T));
+				return value;
+			}
+
+		public:
+			TinyVkSeqLock(const T& value = T()) { Write(value); }
+			TinyVkSeqLock(const TinyVkSeqLock&) = delete;
+			TinyVkSeqLock& operator=(const TinyVkSeqLock&) = delete;
+
+			/// <summary>Replaces the state (writers are serialized, readers are never blocked).</summary>
+			void Store(const T& value) {
+				TinyVkLockGuard g(write_lock);
+				Write(value);
+			}
+
+			/// <summary>Modifies the state in place with update(T&) (read-modify-write without losing concurrent updates).</summary>
+			template<typename F>
+			void Update(F update) {
+				TinyVkLockGuard g(write_lock);
+				T value = ReadLocked();
+				update(value);
+				Write(value);
+			}
+
+			/// <summary>Returns a consistent copy of the state (retries while a write overlaps the read).</summary>
+			T Load() const {
+				uint64_t buffer[WordCount];
+
+				for (;;) {
+					uint64_t start = sequence.load(std::memory_order_acquire);
+					if (start & 1) { TINYVK_CPU_RELAX(); continue; }
+
+					for (size_t w = 0; w < WordCount; w++) buffer[w] = words[w].load(std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (sequence.load(std::memory_order_relaxed) == start) break;
+				}
+
+				T value;
+				std::memcpy(&value, buffer, sizeof(T));
+				return value;
+			}
+		};
+	}
+#endif
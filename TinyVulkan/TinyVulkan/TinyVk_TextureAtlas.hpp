@@ -0,0 +1,409 @@
+#pragma once
+#ifndef TINYVK_TINYVKTEXTUREATLAS
+#define TINYVK_TINYVKTEXTUREATLAS
+	#include "./TinyVulkan.hpp"
+	#include <numeric>
+	#include <unordered_map>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			The TinyVkTextureAtlas builds a single TinyVkImage out of many small images (sprites, glyphs, tiles), so a
+			batch of draws binds one texture with one push-descriptor update instead of one per image.
+
+			Images are added as QOI data/files/asset pack entries or raw pixels (in the atlas format) and are placed
+			on pages of pageWidth x pageHeight when Build() is called:
+				TINYVK_ATLAS_PACKED:	images are packed with a skyline (bottom-left) packer, tallest images first.
+				TINYVK_ATLAS_LAYERS:	every image gets its own page at (0, 0), i.e. a classic texture array.
+
+			Every page is an array layer of the atlas image (VK_IMAGE_VIEW_TYPE_2D_ARRAY with more than one page, a
+			plain 2D image with a single page). All pages are composed into one staging buffer and uploaded with one
+			command buffer. Packed images are surrounded by padding texels that repeat the image edges, so linear
+			filtering does not bleed neighbouring images into each other (use more padding for deeper mip levels).
+
+			Compressed (BC7/ETC2 RGBA) atlases compose their pages as RGBA texels and encode every page and mip level on
+			the CPU before the upload, packed images are aligned to 4x4 texel blocks.
+
+			GetRect() returns the page (array layer), texel rect and UV rect of an image, pass uvRect to
+			TinyVkQuad::CreateFromAtlasRect() and the layer to the shader (e.g. as a push constant) for array atlases.
+		*/
+
+		/// <summary>Placement of images in a TinyVkTextureAtlas.</summary>
+		enum class TinyVkAtlasLayout {
+			TINYVK_ATLAS_PACKED,	/// Pack many images per page with a skyline packer.
+			TINYVK_ATLAS_LAYERS		/// One image per page (texture array).
+		};
+
+		/// <summary>Location of an image within a TinyVkTextureAtlas.</summary>
+		struct TinyVkAtlasRect {
+			uint32_t layer;
+			uint32_t x, y, width, height;
+			glm::vec4 uvRect; /// (u1, v1, u2, v2)
+		};
+
+		/// <summary>Skyline bottom-left rectangle packer for a single atlas page.</summary>
+		class TinyVkSkylinePacker {
+		private:
+			struct TinyVkSkylineNode { uint32_t x, y, width; };
+
+			uint32_t width, height;
+			std::vector<TinyVkSkylineNode> skyline;
+
+			/// <summary>Returns true if a rect of w x h fits on top of the skyline starting at node index and outputs its y.</summary>
+			bool Fit(size_t index, uint32_t w, uint32_t h, uint32_t& y) {
+				if (skyline[index].x + w > width) return false;
+
+				y = skyline[index].y;
+				for (int64_t widthLeft = w; widthLeft > 0; index++) {
+					y = std::max(y, skyline[index].y);
+					if (y + h > height) return false;
+					widthLeft -= skyline[index].width;
+				}
+
+				return true;
+			}
+
+		public:
+			/// <summary>Creates an empty skyline packer for a page of width x height.</summary>
+			TinyVkSkylinePacker(uint32_t width, uint32_t height) : width(width), height(height) { Reset(); }
+
+			/// <summary>Removes every packed rect.</summary>
+			void Reset() { skyline.assign(1, { 0, 0, width }); }
+
+			/// <summary>Packs a rect of w x h at the lowest (then narrowest fitting) position. Returns false if the page is full.</summary>
+			bool Pack(uint32_t w, uint32_t h, uint32_t& x, uint32_t& y) {
+				if (w == 0 || h == 0 || w > width || h > height) return false;
+
+				size_t bestIndex = SIZE_MAX;
+				uint32_t bestTop = UINT32_MAX, bestWidth = UINT32_MAX;
+				for (size_t i = 0; i < skyline.size(); i++) {
+					uint32_t fitY;
+					if (Fit(i, w, h, fitY) && (fitY + h < bestTop || (fitY + h == bestTop && skyline[i].width < bestWidth))) {
+						bestIndex = i;
+						bestTop = fitY + h;
+						bestWidth = skyline[i].width;
+						x = skyline[i].x;
+						y = fitY;
+					}
+				}
+
+				if (bestIndex == SIZE_MAX) return false;
+
+				skyline.insert(skyline.begin() + bestIndex, { x, y + h, w });
+				for (size_t i = bestIndex + 1; i < skyline.size();) {
+					uint32_t end = skyline[i - 1].x + skyline[i - 1].width;
+					if (skyline[i].x >= end) break;
+
+					uint32_t shrink = end - skyline[i].x;
+					if (skyline[i].width <= shrink) {
+						skyline.erase(skyline.begin() + i);
+						continue;
+					}
+
+					skyline[i].x += shrink;
+					skyline[i].width -= shrink;
+					break;
+				}
+
+				for (size_t i = 0; i + 1 < skyline.size();) {
+					if (skyline[i].y == skyline[i + 1].y) {
+						skyline[i].width += skyline[i + 1].width;
+						skyline.erase(skyline.begin() + i + 1);
+					} else i++;
+				}
+
+				return true;
+			}
+		};
+
+		/// <summary>Builds texture atlases/arrays from many images and uploads them as a single TinyVkImage.</summary>
+		class TinyVkTextureAtlas : public TinyVkDisposable {
+		private:
+			struct TinyVkAtlasSource {
+				std::string name;
+				uint32_t width, height;
+				std::vector<uint8_t> pixels;
+			};
+
+			std::vector<TinyVkAtlasSource> sources;
+			std::vector<TinyVkAtlasRect> rects;
+			std::unordered_map<std::string, size_t> names;
+			TinyVkImage* image = nullptr;
+			uint32_t pageCount = 0;
+
+			/// <summary>Places every source image on a page and returns the number of pages.</summary>
+			uint32_t PlaceImages() {
+				std::vector<size_t> order(sources.size());
+				std::iota(order.begin(), order.end(), 0);
+				std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+					return (sources[a].height != sources[b].height) ? sources[a].height > sources[b].height : sources[a].width > sources[b].width;
+				});
+
+				std::vector<TinyVkSkylinePacker> pages;
+				rects.resize(sources.size());
+
+				for (size_t index : order) {
+					TinyVkAtlasSource& source = sources[index];
+					TinyVkAtlasRect& rect = rects[index];
+					rect.width = source.width;
+					rect.height = source.height;
+
+					if (layout == TinyVkAtlasLayout::TINYVK_ATLAS_LAYERS) {
+						if (source.width > pageWidth || source.height > pageHeight)
+							throw std::runtime_error("TinyVulkan: Atlas image is larger than the atlas page: " + source.name);
+
+						rect.layer = static_cast<uint32_t>(index);
+						rect.x = rect.y = 0;
+						continue;
+					}
+
+					// Compressed atlases pack whole 4x4 blocks, so no block (and its endpoints) is shared by two images.
+					uint32_t align = (TinyVkImage::IsCompressedFormat(format)) ? 4 : 1;
+					uint32_t packWidth = (source.width + padding * 2 + align - 1) / align * align;
+					uint32_t packHeight = (source.height + padding * 2 + align - 1) / align * align;
+
+					uint32_t x, y, layer = 0;
+					for (; layer < pages.size(); layer++)
+						if (pages[layer].Pack(packWidth, packHeight, x, y)) break;
+
+					if (layer == pages.size()) {
+						pages.emplace_back(pageWidth, pageHeight);
+						if (!pages.back().Pack(packWidth, packHeight, x, y))
+							throw std::runtime_error("TinyVulkan: Atlas image (plus padding) is larger than the atlas page: " + source.name);
+					}
+
+					rect.layer = layer;
+					rect.x = x + padding;
+					rect.y = y + padding;
+				}
+
+				for (TinyVkAtlasRect& rect : rects)
+					rect.uvRect = glm::vec4(
+						static_cast<float>(rect.x) / pageWidth, static_cast<float>(rect.y) / pageHeight,
+						static_cast<float>(rect.x + rect.width) / pageWidth, static_cast<float>(rect.y + rect.height) / pageHeight);
+
+				return (layout == TinyVkAtlasLayout::TINYVK_ATLAS_LAYERS) ? static_cast<uint32_t>(sources.size()) : static_cast<uint32_t>(pages.size());
+			}
+
+			/// <summary>Copies a source image (and its edge-repeating padding) into its page of the (RGBA/BGRA texel) pages.</summary>
+			void ComposeImage(uint8_t* pages, const TinyVkAtlasSource& source, const TinyVkAtlasRect& rect) {
+				const size_t pageRowSize = static_cast<size_t>(pageWidth) * 4;
+				const size_t rowSize = static_cast<size_t>(source.width) * 4;
+				uint8_t* page = pages + static_cast<size_t>(rect.layer) * pageRowSize * pageHeight;
+				uint32_t pad = (layout == TinyVkAtlasLayout::TINYVK_ATLAS_PACKED) ? padding : 0;
+
+				for (int64_t row = -static_cast<int64_t>(pad); row < static_cast<int64_t>(source.height + pad); row++) {
+					int64_t srcRow = std::clamp<int64_t>(row, 0, source.height - 1);
+					const uint8_t* src = source.pixels.data() + srcRow * rowSize;
+					uint8_t* dst = page + (rect.y + row) * pageRowSize + static_cast<size_t>(rect.x) * 4;
+
+					for (uint32_t i = 1; i <= pad; i++) {
+						std::memcpy(dst - i * 4, src, 4);
+						std::memcpy(dst + rowSize + (i - 1) * 4, src + rowSize - 4, 4);
+					}
+
+					std::memcpy(dst, src, rowSize);
+				}
+			}
+
+			/// <summary>Adds decoded pixels to the atlas and returns the image index.</summary>
+			size_t AddSource(const std::string& name, uint32_t width, uint32_t height, std::vector<uint8_t>&& pixels) {
+				if (image != nullptr)
+					throw std::runtime_error("TinyVulkan: Cannot add images to a TinyVkTextureAtlas that has already been built!");
+
+				if (names.find(name) != names.end())
+					throw std::runtime_error("TinyVulkan: Duplicate TinyVkTextureAtlas image name: " + name);
+
+				names[name] = sources.size();
+				sources.push_back({ name, width, height, std::move(pixels) });
+				return sources.size() - 1;
+			}
+
+		public:
+			TinyVkVulkanDevice& vkdevice;
+			TinyVkGraphicsPipeline& graphicsPipeline;
+			TinyVkCommandPool& commandPool;
+
+			const uint32_t pageWidth, pageHeight, padding;
+			const TinyVkAtlasLayout layout;
+			const VkFormat format;
+			const bool generateMipmaps;
+
+			TinyVkTextureAtlas(const TinyVkTextureAtlas&) = delete;
+			TinyVkTextureAtlas& operator=(const TinyVkTextureAtlas&) = delete;
+
+			~TinyVkTextureAtlas() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				if (image != nullptr) {
+					image->Dispose(waitIdle);
+					delete image;
+				}
+
+				image = nullptr;
+			}
+
+			/// <summary>Creates an empty atlas of pageWidth x pageHeight pages in an 8-bit RGBA/BGRA or BC7/ETC2 RGBA format (padding only applies to TINYVK_ATLAS_PACKED).</summary>
+			TinyVkTextureAtlas(TinyVkVulkanDevice& vkdevice, TinyVkGraphicsPipeline& graphicsPipeline, TinyVkCommandPool& commandPool, uint32_t pageWidth, uint32_t pageHeight, TinyVkAtlasLayout layout = TinyVkAtlasLayout::TINYVK_ATLAS_PACKED, VkFormat format = VK_FORMAT_B8G8R8A8_SRGB, uint32_t padding = 1, bool generateMipmaps = false)
+			: vkdevice(vkdevice), graphicsPipeline(graphicsPipeline), commandPool(commandPool), pageWidth(pageWidth), pageHeight(pageHeight), padding(padding), layout(layout), format(format), generateMipmaps(generateMipmaps) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				bool swizzleBGR;
+				if (!TinyVkImage::GetQoiFormatSwizzle(format, swizzleBGR) && !TinyVkBlockEncoder::IsEncodableFormat(format))
+					throw std::runtime_error("TinyVulkan: TinyVkTextureAtlas only supports 8-bit RGBA/BGRA and BC7/ETC2 RGBA formats!");
+
+				if (pageWidth == 0 || pageHeight == 0)
+					throw std::runtime_error("TinyVulkan: TinyVkTextureAtlas page size must not be 0!");
+
+				SetOwner(vkdevice);
+			}
+
+			/// <summary>Adds raw pixels (width x height texels in the atlas format, RGBA for compressed atlases) and returns the image index.</summary>
+			size_t AddPixels(const std::string& name, const void* pixels, uint32_t width, uint32_t height) {
+				if (width == 0 || height == 0)
+					throw std::runtime_error("TinyVulkan: TinyVkTextureAtlas image size must not be 0: " + name);
+
+				const uint8_t* data = static_cast<const uint8_t*>(pixels);
+				return AddSource(name, width, height, std::vector<uint8_t>(data, data + static_cast<size_t>(width) * height * 4));
+			}
+
+			/// <summary>Decodes a plain or tiled QOI image (swizzled to the atlas format) and returns the image index.</summary>
+			size_t AddQoiImage(const std::string& name, const void* data, size_t dataSize) {
+				bool swizzleBGR = false;
+				TinyVkImage::GetQoiFormatSwizzle(format, swizzleBGR);
+
+				qoi_desc desc;
+				if (!TinyVkTiledQoi::ReadHeader(data, dataSize, desc))
+					throw std::runtime_error("TinyVulkan: Atlas image is not a valid QOI image: " + name);
+
+				std::vector<uint8_t> pixels(static_cast<size_t>(desc.width) * desc.height * 4);
+				TinyVkTiledQoi::DecodeInto(data, dataSize, desc, pixels.data(), pixels.size(), 4, swizzleBGR);
+				return AddSource(name, desc.width, desc.height, std::move(pixels));
+			}
+
+			/// <summary>Memory-maps and decodes a plain or tiled QOI image file, the image is named by its path. Returns the image index.</summary>
+			size_t AddQoiFile(const std::string& path) {
+				TinyVkMappedFile file(path);
+				return AddQoiImage(path, file.GetData(), file.GetSize());
+			}
+
+			/// <summary>Adds a QOI or raw pixel (in the atlas format, RGBA for compressed atlases) asset from an asset pack, the image is named by its entry name. Returns the image index.</summary>
+			size_t AddAssetImage(TinyVkAssetPack& assetPack, const std::string& name) {
+				const TinyVkAssetEntry& entry = assetPack.GetEntry(name);
+
+				if (entry.type == TinyVkAssetType::TINYVK_ASSET_QOI) {
+					std::vector<uint8_t> scratch;
+					return AddQoiImage(name, assetPack.MapEntry(entry, scratch), static_cast<size_t>(entry.size));
+				}
+
+				if (entry.type != TinyVkAssetType::TINYVK_ASSET_PIXELS)
+					throw std::runtime_error("TinyVulkan: Asset is not an image: " + name);
+
+				VkFormat sourceFormat = static_cast<VkFormat>(entry.format);
+				bool compressedSource = TinyVkBlockEncoder::IsEncodableFormat(format) && (sourceFormat == VK_FORMAT_R8G8B8A8_UNORM || sourceFormat == VK_FORMAT_R8G8B8A8_SRGB);
+				if ((sourceFormat != format && !compressedSource) || entry.width == 0 || entry.height == 0 || entry.size != static_cast<uint64_t>(entry.width) * entry.height * 4)
+					throw std::runtime_error("TinyVulkan: Asset pixels do not match the atlas format: " + name);
+
+				std::vector<uint8_t> pixels(static_cast<size_t>(entry.size));
+				assetPack.ReadInto(entry, pixels.data(), pixels.size());
+				return AddSource(name, entry.width, entry.height, std::move(pixels));
+			}
+
+			/// <summary>Packs every added image into pages and uploads all pages in one batch, CPU copies of the images are released.</summary>
+			void Build() {
+				if (image != nullptr)
+					throw std::runtime_error("TinyVulkan: TinyVkTextureAtlas has already been built!");
+
+				if (sources.empty())
+					throw std::runtime_error("TinyVulkan: TinyVkTextureAtlas has no images to build!");
+
+				pageCount = PlaceImages();
+
+				VkPhysicalDeviceProperties properties{};
+				vkGetPhysicalDeviceProperties(vkdevice.physicalDevice, &properties);
+				if (pageCount > properties.limits.maxImageArrayLayers)
+					throw std::runtime_error("TinyVulkan: TinyVkTextureAtlas needs more pages than the device supports array layers!");
+
+				uint32_t mipLevels = (generateMipmaps) ? TinyVkImage::GetMaxMipLevels(pageWidth, pageHeight) : 1;
+				image = new TinyVkImage(vkdevice, graphicsPipeline, commandPool, pageWidth, pageHeight, false, format, TINYVK_UNDEFINED, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, pageCount);
+
+				if (!TinyVkImage::IsCompressedFormat(format)) {
+					VkDeviceSize stagingSize = image->GetMipByteSize(0);
+					image->StageImageDataWith(stagingSize, [this, stagingSize](void* mappedData) {
+						uint8_t* pages = static_cast<uint8_t*>(mappedData);
+						std::memset(pages, 0, static_cast<size_t>(stagingSize));
+
+						for (size_t i = 0; i < sources.size(); i++)
+							ComposeImage(pages, sources[i], rects[i]);
+					});
+				} else {
+					// Compressed pages are composed as RGBA, then every page and mip level is encoded (compressed images cannot be blitted).
+					const size_t pageSize = static_cast<size_t>(pageWidth) * pageHeight * 4;
+					std::vector<uint8_t> pages(pageSize * pageCount, 0);
+					for (size_t i = 0; i < sources.size(); i++)
+						ComposeImage(pages.data(), sources[i], rects[i]);
+
+					std::vector<std::vector<uint8_t>> chains(pageCount);
+					for (uint32_t layer = 0; layer < pageCount; layer++)
+						chains[layer] = TinyVkBlockEncoder::EncodeMipChain(format, pages.data() + layer * pageSize, pageWidth, pageHeight, mipLevels);
+
+					image->StageImageDataWith(image->GetMipChainByteSize(mipLevels), [this, &chains, mipLevels](void* mappedData) {
+						uint8_t* staging = static_cast<uint8_t*>(mappedData);
+						size_t chainOffset = 0;
+
+						for (uint32_t level = 0; level < mipLevels; level++) {
+							size_t levelSize = TinyVkBlockEncoder::GetEncodedSize(TinyVkImage::GetMipExtent(pageWidth, level), TinyVkImage::GetMipExtent(pageHeight, level));
+							for (uint32_t layer = 0; layer < pageCount; layer++, staging += levelSize)
+								std::memcpy(staging, chains[layer].data() + chainOffset, levelSize);
+
+							chainOffset += levelSize;
+						}
+					}, mipLevels);
+				}
+
+				sources.clear();
+				sources.shrink_to_fit();
+			}
+
+			/// <summary>Returns true if the atlas has been built and uploaded.</summary>
+			bool IsBuilt() { return image != nullptr; }
+
+			/// <summary>Returns the atlas image (all pages as array layers), throws if the atlas has not been built.</summary>
+			TinyVkImage& GetImage() {
+				if (image == nullptr)
+					throw std::runtime_error("TinyVulkan: TinyVkTextureAtlas has not been built!");
+
+				return *image;
+			}
+
+			/// <summary>Returns the number of pages (array layers) of the built atlas.</summary>
+			uint32_t GetPageCount() { return pageCount; }
+
+			/// <summary>Returns the number of images in the atlas.</summary>
+			size_t GetImageCount() { return names.size(); }
+
+			/// <summary>Returns the index of a named image or SIZE_MAX if the atlas has no such image.</summary>
+			size_t Find(const std::string& name) {
+				auto found = names.find(name);
+				return (found != names.end()) ? found->second : SIZE_MAX;
+			}
+
+			/// <summary>Returns the location of an image by index, throws if the atlas has not been built.</summary>
+			const TinyVkAtlasRect& GetRect(size_t index) {
+				if (image == nullptr || index >= rects.size())
+					throw std::runtime_error("TinyVulkan: TinyVkTextureAtlas has not been built or the image index is out of range!");
+
+				return rects[index];
+			}
+
+			/// <summary>Returns the location of a named image, throws if the atlas has not been built or has no such image.</summary>
+			const TinyVkAtlasRect& GetRect(const std::string& name) {
+				size_t index = Find(name);
+				if (index == SIZE_MAX)
+					throw std::runtime_error("TinyVulkan: TinyVkTextureAtlas has no image named: " + name);
+
+				return GetRect(index);
+			}
+		};
+	}
+
+#endif
@@ -0,0 +1,218 @@
+#pragma once
+#ifndef TINYVK_TINYVKTILEDQOI
+#define TINYVK_TINYVKTILEDQOI
+	#include "./TinyVulkan.hpp"
+	#include <climits>
+	#include <cstring>
+	#include <functional>
+	#include <thread>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			QOI is a sequential format (every pixel depends on the previous one), so one image is encoded/decoded on one core.
+			The tiled QOI container splits the image into horizontal strips of stripRows rows which are each encoded as an
+			independent plain QOI image, so large images (e.g. 4K atlases) are encoded/decoded in parallel across threads.
+
+			Tiled QOI Container: (all integers big-endian, like QOI)
+				char[4]		magic			"qoit"
+				uint32_t	width			Full image width in pixels.
+				uint32_t	height			Full image height in pixels.
+				uint8_t		channels		3 = RGB, 4 = RGBA.
+				uint8_t		colorspace		0 = sRGB with linear alpha, 1 = all channels linear.
+				uint32_t	stripRows		Rows per strip (the last strip holds the remaining rows).
+				uint32_t	stripCount		Number of strips.
+				uint64_t	offsets[stripCount + 1]	File offsets of each strip; offsets[stripCount] is the file size.
+				...			strips			Each strip is a complete plain QOI image (header, chunks, padding) of width x rows.
+
+			Images that fit in one strip are written as plain QOI images ("qoif"), and Decode() accepts both plain
+			and tiled images, so single-strip files remain readable by any QOI decoder.
+		*/
+
+		/// <summary>Tiled QOI container: parallel encoding/decoding of large images as independent QOI strips.</summary>
+		class TinyVkTiledQoi {
+		private:
+			static constexpr uint32_t QOIT_MAGIC = (((uint32_t)'q') << 24) | (((uint32_t)'o') << 16) | (((uint32_t)'i') << 8) | ((uint32_t)'t');
+			static constexpr uint32_t QOIF_MAGIC = (((uint32_t)'q') << 24) | (((uint32_t)'o') << 16) | (((uint32_t)'i') << 8) | ((uint32_t)'f');
+			static constexpr size_t QOIT_HEADER_SIZE = 22;
+			static constexpr uint32_t QOIT_MIN_STRIP_ROWS = 64;
+
+			static uint64_t ReadBigEndian(const uint8_t* bytes, size_t count) {
+				uint64_t value = 0;
+				for (size_t i = 0; i < count; i++) value = (value << 8) | bytes[i];
+				return value;
+			}
+
+			static void WriteBigEndian(uint8_t* bytes, uint64_t value, size_t count) {
+				for (size_t i = 0; i < count; i++) bytes[i] = static_cast<uint8_t>(value >> ((count - 1 - i) * 8));
+			}
+
+		public:
+			/// <summary>Runs task(index) for every index in [0, count) on up to threadCount threads of the default TinyVkJobSystem (the calling thread included).</summary>
+			static void ParallelFor(size_t count, size_t threadCount, const std::function<void(size_t)>& task) {
+				TinyVkJobSystem::Default().ParallelFor(count, task, threadCount);
+			}
+
+			/// <summary>Returns threadCount or the hardware concurrency if threadCount is 0.</summary>
+			static size_t GetThreadCount(size_t threadCount) {
+				return (threadCount > 0) ? threadCount : std::max(1U, std::thread::hardware_concurrency());
+			}
+
+			/// <summary>Reads the image description of a plain or tiled QOI image. Returns false if the data is not a valid QOI image.</summary>
+			static bool ReadHeader(const void* data, size_t size, qoi_desc& desc, uint32_t* stripCount = nullptr) {
+				const uint8_t* bytes = static_cast<const uint8_t*>(data);
+				if (bytes == nullptr || size < QOI_HEADER_SIZE) return false;
+
+				uint32_t magic = static_cast<uint32_t>(ReadBigEndian(bytes, 4));
+				if (magic != QOIF_MAGIC && magic != QOIT_MAGIC) return false;
+
+				desc.width = static_cast<unsigned int>(ReadBigEndian(bytes + 4, 4));
+				desc.height = static_cast<unsigned int>(ReadBigEndian(bytes + 8, 4));
+				desc.channels = bytes[12];
+				desc.colorspace = bytes[13];
+
+				if (desc.width == 0 || desc.height == 0 || desc.channels < 3 || desc.channels > 4 || desc.colorspace > 1)
+					return false;
+
+				uint32_t strips = 1;
+				if (magic == QOIT_MAGIC) {
+					if (size < QOIT_HEADER_SIZE) return false;
+					strips = static_cast<uint32_t>(ReadBigEndian(bytes + 18, 4));
+				}
+
+				if (stripCount != nullptr) *stripCount = strips;
+				return true;
+			}
+
+			/// <summary>Encodes pixels as a tiled QOI image of stripRows rows per strip (0 = one strip per thread, at least 64 rows) across threadCount threads (0 = hardware concurrency).</summary>
+			static std::vector<uint8_t> Encode(const void* pixels, const qoi_desc& desc, uint32_t stripRows = 0, size_t threadCount = 0) {
+				if (pixels == nullptr || desc.width == 0 || desc.height == 0 || desc.channels < 3 || desc.channels > 4 || desc.colorspace > 1)
+					throw std::runtime_error("TinyVulkan: Invalid tiled QOI image description!");
+
+				threadCount = GetThreadCount(threadCount);
+				if (stripRows == 0)
+					stripRows = std::max(QOIT_MIN_STRIP_ROWS, static_cast<uint32_t>((desc.height + threadCount - 1) / threadCount));
+
+				uint32_t stripCount = (desc.height + stripRows - 1) / stripRows;
+				size_t rowSize = static_cast<size_t>(desc.width) * desc.channels;
+				std::vector<std::pair<void*, int>> strips(stripCount, { nullptr, 0 });
+
+				try {
+					ParallelFor(stripCount, threadCount, [&](size_t strip) {
+						qoi_desc stripDesc = desc;
+						stripDesc.height = std::min(stripRows, desc.height - static_cast<uint32_t>(strip) * stripRows);
+
+						const uint8_t* stripPixels = static_cast<const uint8_t*>(pixels) + strip * stripRows * rowSize;
+						strips[strip].first = qoi_encode(stripPixels, &stripDesc, &strips[strip].second);
+						if (strips[strip].first == nullptr)
+							throw std::runtime_error("TinyVulkan: Failed to encode tiled QOI image strip " + std::to_string(strip) + "!");
+					});
+				} catch (...) {
+					for (auto& strip : strips) QOI_FREE(strip.first);
+					throw;
+				}
+
+				std::vector<uint8_t> encoded;
+				if (stripCount == 1) {
+					// Single strip images are written as plain QOI images.
+					const uint8_t* bytes = static_cast<const uint8_t*>(strips[0].first);
+					encoded.assign(bytes, bytes + strips[0].second);
+					QOI_FREE(strips[0].first);
+					return encoded;
+				}
+
+				size_t tableSize = (static_cast<size_t>(stripCount) + 1) * sizeof(uint64_t);
+				size_t encodedSize = QOIT_HEADER_SIZE + tableSize;
+				for (auto& strip : strips) encodedSize += strip.second;
+				encoded.resize(encodedSize);
+
+				uint8_t* bytes = encoded.data();
+				WriteBigEndian(bytes, QOIT_MAGIC, 4);
+				WriteBigEndian(bytes + 4, desc.width, 4);
+				WriteBigEndian(bytes + 8, desc.height, 4);
+				bytes[12] = desc.channels;
+				bytes[13] = desc.colorspace;
+				WriteBigEndian(bytes + 14, stripRows, 4);
+				WriteBigEndian(bytes + 18, stripCount, 4);
+
+				size_t offset = QOIT_HEADER_SIZE + tableSize;
+				for (uint32_t i = 0; i < stripCount; i++) {
+					WriteBigEndian(bytes + QOIT_HEADER_SIZE + i * sizeof(uint64_t), offset, 8);
+					std::memcpy(bytes + offset, strips[i].first, strips[i].second);
+					offset += strips[i].second;
+					QOI_FREE(strips[i].first);
+				}
+
+				WriteBigEndian(bytes + QOIT_HEADER_SIZE + stripCount * sizeof(uint64_t), offset, 8);
+				return encoded;
+			}
+
+			/// <summary>Decodes a plain or tiled QOI image directly into the pixels buffer (e.g. mapped staging memory) of pixelsSize bytes, swapping red/blue if swizzleBGR is set.</summary>
+			static void DecodeInto(const void* data, size_t size, qoi_desc& desc, void* pixels, size_t pixelsSize, int channels = 0, bool swizzleBGR = false, size_t threadCount = 0) {
+				uint32_t stripCount;
+				if (pixels == nullptr || (channels != 0 && channels != 3 && channels != 4) || !ReadHeader(data, size, desc, &stripCount))
+					throw std::runtime_error("TinyVulkan: Invalid tiled QOI image!");
+
+				if (channels == 0) channels = desc.channels;
+				size_t rowSize = static_cast<size_t>(desc.width) * channels;
+				if (pixelsSize < rowSize * desc.height)
+					throw std::runtime_error("TinyVulkan: Tiled QOI decode destination is too small!");
+
+				const uint8_t* bytes = static_cast<const uint8_t*>(data);
+				int flags = swizzleBGR ? QOI_DECODE_BGR : 0;
+
+				if (static_cast<uint32_t>(ReadBigEndian(bytes, 4)) == QOIF_MAGIC) {
+					qoi_desc plainDesc;
+					if (size > INT_MAX || !qoi_decode_into(data, static_cast<int>(size), &plainDesc, pixels, static_cast<int>(std::min<size_t>(pixelsSize, INT_MAX)), channels, flags))
+						throw std::runtime_error("TinyVulkan: Failed to decode QOI image!");
+					return;
+				}
+
+				uint32_t stripRows = static_cast<uint32_t>(ReadBigEndian(bytes + 14, 4));
+				size_t tableSize = (static_cast<size_t>(stripCount) + 1) * sizeof(uint64_t);
+				if (stripRows == 0 || stripCount == 0 || stripCount != (desc.height + stripRows - 1) / stripRows || size < QOIT_HEADER_SIZE + tableSize)
+					throw std::runtime_error("TinyVulkan: Invalid tiled QOI strip table!");
+
+				ParallelFor(stripCount, GetThreadCount(threadCount), [&](size_t strip) {
+					uint64_t begin = ReadBigEndian(bytes + QOIT_HEADER_SIZE + strip * sizeof(uint64_t), 8);
+					uint64_t end = ReadBigEndian(bytes + QOIT_HEADER_SIZE + (strip + 1) * sizeof(uint64_t), 8);
+					if (begin < QOIT_HEADER_SIZE + tableSize || end < begin || end > size || end - begin > INT_MAX)
+						throw std::runtime_error("TinyVulkan: Invalid tiled QOI strip offset " + std::to_string(strip) + "!");
+
+					uint32_t rows = std::min(stripRows, desc.height - static_cast<uint32_t>(strip) * stripRows);
+					size_t stripSize = rows * rowSize;
+					qoi_desc stripDesc;
+
+					// Headers are checked first so a mismatched strip can never write outside of its rows.
+					if (!qoi_read_header(bytes + begin, static_cast<int>(end - begin), &stripDesc) || stripDesc.width != desc.width || stripDesc.height != rows || stripSize > INT_MAX ||
+						!qoi_decode_into(bytes + begin, static_cast<int>(end - begin), &stripDesc, static_cast<uint8_t*>(pixels) + strip * stripRows * rowSize, static_cast<int>(stripSize), channels, flags))
+						throw std::runtime_error("TinyVulkan: Failed to decode tiled QOI image strip " + std::to_string(strip) + "!");
+				});
+			}
+
+			/// <summary>Decodes a plain or tiled QOI image to channels (0 = file channels) pixels across threadCount threads (0 = hardware concurrency).</summary>
+			static std::vector<uint8_t> Decode(const void* data, size_t size, qoi_desc& desc, int channels = 0, size_t threadCount = 0) {
+				if ((channels != 0 && channels != 3 && channels != 4) || !ReadHeader(data, size, desc))
+					throw std::runtime_error("TinyVulkan: Invalid tiled QOI image!");
+
+				std::vector<uint8_t> pixels(static_cast<size_t>(desc.width) * desc.height * ((channels == 0) ? desc.channels : channels));
+				DecodeInto(data, size, desc, pixels.data(), pixels.size(), channels, false, threadCount);
+				return pixels;
+			}
+
+			/// <summary>Encodes pixels as a tiled QOI image and writes it to the file path.</summary>
+			static void Write(const std::string& path, const void* pixels, const qoi_desc& desc, uint32_t stripRows = 0, size_t threadCount = 0) {
+				std::vector<uint8_t> encoded = Encode(pixels, desc, stripRows, threadCount);
+				std::ofstream file(path, std::ios::binary | std::ios::trunc);
+				if (!file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size()))
+					throw std::runtime_error("TinyVulkan: Failed to write tiled QOI image: " + path);
+			}
+
+			/// <summary>Reads (memory-maps) and decodes a plain or tiled QOI image from the file path.</summary>
+			static std::vector<uint8_t> Read(const std::string& path, qoi_desc& desc, int channels = 0, size_t threadCount = 0) {
+				TinyVkMappedFile file(path);
+				return Decode(file.GetData(), file.GetSize(), desc, channels, threadCount);
+			}
+		};
+	}
+
+#endif
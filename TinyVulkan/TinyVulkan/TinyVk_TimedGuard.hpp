@@ -10,20 +10,48 @@
 		private:
 			bool signal;
 			std::timed_mutex& lock;
+			#ifdef TINYVK_LOCK_INSTRUMENTATION
+			TinyVkLockSite& site;
+			std::chrono::steady_clock::time_point acquired;
+			#endif
 
 		public:
 			bool Acquired() { return signal; }
 
-			void Unlock() { if (signal) lock.unlock(); }
+			void Unlock() {
+				if (!signal) return;
+				#ifdef TINYVK_LOCK_INSTRUMENTATION
+				site.RecordRelease(TinyVkLockInstrumentation::Nanoseconds(acquired, std::chrono::steady_clock::now()));
+				#endif
+				lock.unlock();
+				signal = false;
+			}
 
 			~timed_guard() noexcept { Unlock(); }
 
 			/// <summary>Creates a timed lock_guard() which accepts a mutex.</summary>
+			#ifdef TINYVK_LOCK_INSTRUMENTATION
+			explicit timed_guard(std::timed_mutex& lock, const std::source_location location = std::source_location::current())
+				: lock(lock), site(TinyVkLockInstrumentation::GetSite(location)) {
+				auto start = std::chrono::steady_clock::now();
+				bool contended = !(signal = lock.try_lock());
+
+				if (contended) {
+					if (wait) {
+						signal = lock.try_lock_for(std::chrono::milliseconds(timeout));
+					} else { lock.lock(); signal = true; }
+				}
+
+				acquired = std::chrono::steady_clock::now();
+				site.RecordAcquire(TinyVkLockInstrumentation::Nanoseconds(start, acquired), contended, signal);
+			}
+			#else
 			explicit timed_guard(std::timed_mutex& lock) : lock(lock) {
 				if (wait) {
 					signal = lock.try_lock_for(std::chrono::milliseconds(timeout));
 				} else { lock.lock(); signal = true; }
 			}
+			#endif
 
 			timed_guard(const timed_guard&) = delete;
 
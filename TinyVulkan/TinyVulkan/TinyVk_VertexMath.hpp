@@ -128,7 +128,7 @@
             }
 
             static std::vector<TinyVkVertex> CreateFromAtlasExt(glm::vec2 xy, glm::vec3 whd, glm::vec2 atlaswh, const std::vector<glm::vec4> vcolors = defvcolors) {
-                glm::vec2 uv1 = { xy.x / whd.x, xy.y / whd.y };
+                glm::vec2 uv1 = { xy.x / atlaswh.x, xy.y / atlaswh.y };
                 glm::vec2 uv2 = uv1 + glm::vec2(whd.x / atlaswh.x, whd.y / atlaswh.y);
 
                 return {
@@ -139,6 +139,15 @@
                 };
             }
 
+            static std::vector<TinyVkVertex> CreateFromAtlasRectExt(glm::vec4 uvrect, glm::vec3 whd, const std::vector<glm::vec4> vcolors = defvcolors) {
+                return {
+                    TinyVkVertex({uvrect.x, uvrect.y}, {0.0, 0.0, whd.z}, vcolors[0]),
+                    TinyVkVertex({uvrect.z, uvrect.y}, {whd.x, 0.0, whd.z}, vcolors[1]),
+                    TinyVkVertex({uvrect.z, uvrect.w}, {whd.x, whd.y, whd.z}, vcolors[2]),
+                    TinyVkVertex({uvrect.x, uvrect.w}, {0.0, whd.y, whd.z}, vcolors[3]),
+                };
+            }
+
             static std::vector<TinyVkVertex> Create(glm::vec3 whd, const glm::vec4 vcolor = defvcolors[0]) {
                 return CreateExt(whd, { vcolor,vcolor,vcolor,vcolor });
             }
@@ -151,6 +160,10 @@
                 return CreateFromAtlasExt(xy, whd, atlaswh, {vcolor,vcolor,vcolor,vcolor});
             }
 
+            static std::vector<TinyVkVertex> CreateFromAtlasRect(glm::vec4 uvrect, glm::vec3 whd, const glm::vec4 vcolor = defvcolors[0]) {
+                return CreateFromAtlasRectExt(uvrect, whd, {vcolor,vcolor,vcolor,vcolor});
+            }
+
             static void RotateScaleFromOrigin(std::vector<TinyVkVertex>& quad, glm::vec3 origin, glm::float32 radians, glm::float32 scale) {
                 glm::mat2 rotation = glm::mat2(glm::cos(radians), -glm::sin(radians), glm::sin(radians), glm::cos(radians));
                 glm::vec2 pivot = origin;
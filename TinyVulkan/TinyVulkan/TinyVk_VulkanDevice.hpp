@@ -7,6 +7,10 @@
 	namespace TINYVULKAN_NAMESPACE {
 		#define VK_VALIDATION_LAYER_KHRONOS_EXTENSION_NAME "VK_LAYER_KHRONOS_validation"
 
+		#ifdef TINYVK_HEADLESS
+			class TinyVkWindow; // Not available when compiled headless, see TinyVulkan.hpp.
+		#endif
+
 		struct TinyVkQueueFamily {
 			std::optional<uint32_t> graphicsFamily;
 			std::optional<uint32_t> presentFamily;
@@ -23,10 +27,12 @@
 		private:
 			const std::vector<const char*> validationLayers = { VK_VALIDATION_LAYER_KHRONOS_EXTENSION_NAME };
 			const std::vector<const char*> instanceExtensions = {  };
-			const std::vector<const char*> deviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME, VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME };
+			std::vector<const char*> deviceExtensions = { VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME, VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME };
 			const VkPhysicalDeviceFeatures deviceFeatures { .multiDrawIndirect = VK_TRUE, .multiViewport = VK_TRUE };
+			VkPhysicalDeviceFeatures enabledFeatures {};
 			const std::vector<VkPhysicalDeviceType> deviceTypes;
 			std::vector<const char*> presentExtensionNames;
+			TinyVkQueueFamily queueFamilyIndices;
 
 			/// <summary>Creates the underlying Vulkan Instance w/ Required Extensions.</summary>
 			void CreateVkInstance(const std::string& title) {
@@ -124,7 +130,8 @@
 				TinyVkQueueFamily indices = FindQueueFamilies();
 
 				std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-				std::set<uint32_t> uniqueQueueFamilies = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+				std::set<uint32_t> uniqueQueueFamilies = { indices.graphicsFamily.value() };
+				if (indices.HasPresentFamily()) uniqueQueueFamilies.insert(indices.presentFamily.value());
 
 				float queuePriority = 1.0f;
 				for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -140,12 +147,20 @@
 				dynamicRenderingCreateInfo.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
 				dynamicRenderingCreateInfo.dynamicRendering = VK_TRUE;
 
+				// Texture compression features are optional: enabled when the device supports them (see QueryCompressedFormat).
+				VkPhysicalDeviceFeatures supportedFeatures;
+				vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+				enabledFeatures = deviceFeatures;
+				enabledFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+				enabledFeatures.textureCompressionETC2 = supportedFeatures.textureCompressionETC2;
+				enabledFeatures.textureCompressionASTC_LDR = supportedFeatures.textureCompressionASTC_LDR;
+
 				VkDeviceCreateInfo createInfo{};
 				createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 				createInfo.pNext = &dynamicRenderingCreateInfo;
 				createInfo.pQueueCreateInfos = queueCreateInfos.data();
 				createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
-				createInfo.pEnabledFeatures = &deviceFeatures;
+				createInfo.pEnabledFeatures = &enabledFeatures;
 				createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
 				createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
@@ -180,13 +195,19 @@
 			VkDevice logicalDevice = VK_NULL_HANDLE;
 			VkSurfaceKHR presentSurface = VK_NULL_HANDLE;
 			VmaAllocator memoryAllocator = VK_NULL_HANDLE;
+			TinyVkDeletionQueue deletionQueue { logicalDevice };
+			TinyVkSamplerCache samplerCache { logicalDevice, deletionQueue };
 
 			TinyVkVulkanDevice operator=(const TinyVkVulkanDevice&) = delete;
 
 			~TinyVkVulkanDevice() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
+				// One device wait for the whole tree, then every owned object is destroyed immediately (newest first).
 				if (waitIdle) vkDeviceWaitIdle(logicalDevice);
+				DisposeChildren(false);
+				deletionQueue.Flush(false);
+				samplerCache.Flush();
 
 				#if TVK_VALIDATION_LAYERS
 					DestroyDebugUtilsMessengerEXT(instance, debugMessenger, VK_NULL_HANDLE);
@@ -194,26 +215,40 @@
 				
 				vmaDestroyAllocator(memoryAllocator);
 				vkDestroyDevice(logicalDevice, VK_NULL_HANDLE);
-				vkDestroySurfaceKHR(instance, presentSurface, VK_NULL_HANDLE);
+
+				if (presentSurface != VK_NULL_HANDLE)
+					vkDestroySurfaceKHR(instance, presentSurface, VK_NULL_HANDLE);
 				vkDestroyInstance(instance, VK_NULL_HANDLE);
 			}
 
+			/// <summary>Creates the Vulkan instance and devices. If no window is provided the device is headless (surface-less, no swapchain extension).</summary>
 			TinyVkVulkanDevice(const std::string title, const std::vector<VkPhysicalDeviceType> deviceTypes = { VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU, VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU }, TinyVkWindow* window = VK_NULL_HANDLE, const std::vector<const char*> presentExtensionNames = {}) : deviceTypes(deviceTypes), presentExtensionNames(presentExtensionNames) {
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+				disposesChildren = true;
 				
-				CreateVkInstance(title);
-
-				if (window != VK_NULL_HANDLE) {
-					presentSurface = window->CreateWindowSurface(instance);
-
+				#ifdef TINYVK_HEADLESS
+					if (window != VK_NULL_HANDLE)
+						throw std::runtime_error("TinyVulkan: TinyVkVulkanDevice cannot present to a window when compiled with TINYVK_HEADLESS!");
+				#else
 					#ifdef TINYVK_AUTO_PRESENT_EXTENSIONS
-					for (auto str : TinyVkWindow::QueryRequiredExtensions(TVK_VALIDATION_LAYERS))
-						this->presentExtensionNames.push_back(str);
+					if (window != VK_NULL_HANDLE)
+						for (auto str : TinyVkWindow::QueryRequiredExtensions(TVK_VALIDATION_LAYERS))
+							this->presentExtensionNames.push_back(str);
 					#endif
-				}
+				#endif
+
+				CreateVkInstance(title);
+
+				#ifndef TINYVK_HEADLESS
+					if (window != VK_NULL_HANDLE) {
+						presentSurface = window->CreateWindowSurface(instance);
+						deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+					}
+				#endif
 
 				vkCmdRenderingGetCallbacks(instance);
 				QueryPhysicalDevice();
+				queueFamilyIndices = FindQueueFamilies(physicalDevice);
 				CreateLogicalDevice();
 				CreateVMAllocator();
 			}
@@ -226,6 +261,10 @@
 			VkPhysicalDevice GetPhysicalDevice() { return physicalDevice; }
 			VkDevice GetLogicalDevice() { return logicalDevice; }
 			VkSurfaceKHR GetPresentSurface() { return presentSurface; }
+			bool IsHeadless() { return presentSurface == VK_NULL_HANDLE; }
+			TinyVkDeletionQueue& GetDeletionQueue() { return deletionQueue; }
+			TinyVkSamplerCache& GetSamplerCache() { return samplerCache; }
+			const VkPhysicalDeviceFeatures& GetEnabledFeatures() { return enabledFeatures; }
 
 			#pragma endregion
 			#pragma region VULKAN_VALIDATION_LAYERS
@@ -283,8 +322,11 @@
 				vkDeviceWaitIdle(logicalDevice);
 			}
 
-			/// <summary>Returns info about the VkPhysicalDevice graphics/present queue families. If no surface provided, auto checks for Win32 surface support.</summary>
+			/// <summary>Returns info about the VkPhysicalDevice graphics/present queue families (cached for the selected device). Headless devices only query the graphics queue family.</summary>
 			TinyVkQueueFamily FindQueueFamilies(VkPhysicalDevice newDevice = VK_NULL_HANDLE) {
+				if (newDevice == VK_NULL_HANDLE && queueFamilyIndices.HasGraphicsFamily())
+					return queueFamilyIndices;
+
 				VkPhysicalDevice device = (newDevice == VK_NULL_HANDLE)? physicalDevice : newDevice;
 				TinyVkQueueFamily indices;
 
@@ -315,6 +357,24 @@
 				return indices;
 			}
 
+			/// <summary>Returns true if the selected VkPhysicalDevice supports the format features for optimally tiled images of a format (sampled + transfer destination by default).</summary>
+			bool QueryFormatSupport(VkFormat format, VkFormatFeatureFlags features = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT) {
+				VkFormatProperties properties;
+				vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+				return (properties.optimalTilingFeatures & features) == features;
+			}
+
+			/// <summary>Returns the preferred block-compressed RGBA format encodable by TinyVkBlockEncoder (BC7, then ETC2 RGBA8) or VK_FORMAT_B8G8R8A8 if neither is enabled/supported.</summary>
+			VkFormat QueryCompressedFormat(bool srgb = true) {
+				VkFormat bc7 = (srgb) ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+				if (enabledFeatures.textureCompressionBC && QueryFormatSupport(bc7)) return bc7;
+
+				VkFormat etc2 = (srgb) ? VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK : VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+				if (enabledFeatures.textureCompressionETC2 && QueryFormatSupport(etc2)) return etc2;
+
+				return (srgb) ? VK_FORMAT_B8G8R8A8_SRGB : VK_FORMAT_B8G8R8A8_UNORM;
+			}
+
 			/// <summary>Checks the VkPhysicalDevice for swap-chain availability.</summary>
 			TinyVkSwapChainSupporter QuerySwapChainSupport(VkPhysicalDevice device) {
 				TinyVkSwapChainSupporter details;
@@ -379,6 +439,7 @@
 				vkGetPhysicalDeviceFeatures2(device, &deviceFeatures);
 				
 				TinyVkQueueFamily indices = FindQueueFamilies(device);
+				bool supportsExtensions = QueryDeviceExtensionSupport(device);
 
 				bool hasType = false;
 				for (auto type : deviceTypes)
@@ -387,7 +448,7 @@
 						break;
 					}
 
-				return indices.HasGraphicsFamily() && hasType && deviceFeatures.features.multiViewport && deviceFeatures.features.multiDrawIndirect;
+				return indices.HasGraphicsFamily() && hasType && supportsExtensions && deviceFeatures.features.multiViewport && deviceFeatures.features.multiDrawIndirect;
 			}
 			
 			/// <summary>Returns BOOL(true/false) if the VkPhysicalDevice (GPU/iGPU) supports extensions.</summary>
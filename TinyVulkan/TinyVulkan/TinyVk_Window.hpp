@@ -3,76 +3,19 @@
 #define TINYVK_TINYVKWINDOW
 	#include "./TinyVulkan.hpp"
 
-	typedef void (*GLFWgamepadbuttonfun)(const GLFWgamepadstate* gamepad, int32_t gpad, int32_t button, int32_t action);
-	typedef void (*GLFWgamepadaxisfun)(const GLFWgamepadstate* gamepad, int32_t gpad, int32_t axisXID, float_t axisX, int32_t axisYID, float_t axisY);
-	typedef void (*GLFWgamepadtriggerfun)(const GLFWgamepadstate* gamepad, int32_t gpad, int32_t axisXID, float_t axis);
-	GLFWAPI GLFWgamepadbuttonfun glfwGamepadButtonCallback = NULL;
-	GLFWAPI GLFWgamepadaxisfun glfwGamepadAxisCallback = NULL;
-	GLFWAPI GLFWgamepadtriggerfun glfwGamepadTriggerCallback = NULL;
-	GLFWAPI void glfwSetGamepadButtonCallback(GLFWgamepadbuttonfun callback) { glfwGamepadButtonCallback = callback; }
-	GLFWAPI void glfwSetGamepadAxisCallback(GLFWgamepadaxisfun callback) { glfwGamepadAxisCallback = callback; }
-	GLFWAPI void glfwSetGamepadTriggerCallback(GLFWgamepadtriggerfun callback) { glfwGamepadTriggerCallback = callback; }
-	GLFWAPI GLFWgamepadstate glfwGamepadCache[GLFW_JOYSTICK_LAST + 1]{};
-	GLFWAPI float_t glfwRoundfd(float_t value, float_t precision) { return std::round(value * precision) / precision; }
-	GLFWAPI void glfwPollGamepads() {
-		for (int32_t i = 0; i <= GLFW_JOYSTICK_LAST; i++) {
-			if (glfwJoystickPresent(i) == GLFW_FALSE) continue;
-
-			GLFWgamepadstate gpstate;
-			glfwGetGamepadState(i, &gpstate);
-
-			for(int32_t b = 0; b <= GLFW_GAMEPAD_BUTTON_LAST; b++) {
-				if (gpstate.buttons[b] != glfwGamepadCache[i].buttons[b]) {
-					glfwGamepadCache[i].buttons[b] = gpstate.buttons[b];
-					glfwGamepadButtonCallback(&gpstate, i, b, gpstate.buttons[b]);
-				}
-			}
-
-			if (glfwRoundfd(gpstate.axes[GLFW_GAMEPAD_AXIS_LEFT_X], 1000) != glfwRoundfd(glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_LEFT_X], 1000)
-				|| glfwRoundfd(gpstate.axes[GLFW_GAMEPAD_AXIS_LEFT_Y], 1000) != glfwRoundfd(glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_LEFT_Y], 1000)) {
-				glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_LEFT_X] = gpstate.axes[GLFW_GAMEPAD_AXIS_LEFT_X];
-				glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_LEFT_Y] = gpstate.axes[GLFW_GAMEPAD_AXIS_LEFT_Y];
-
-				if (glfwGamepadAxisCallback != NULL)
-					glfwGamepadAxisCallback(&gpstate, i, GLFW_GAMEPAD_AXIS_LEFT_X, gpstate.axes[GLFW_GAMEPAD_AXIS_LEFT_X], GLFW_GAMEPAD_AXIS_LEFT_Y, gpstate.axes[GLFW_GAMEPAD_AXIS_LEFT_Y]);
-			}
-
-			if (glfwRoundfd(gpstate.axes[GLFW_GAMEPAD_AXIS_RIGHT_X], 1000) != glfwRoundfd(glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_RIGHT_X], 1000)
-				|| glfwRoundfd(gpstate.axes[GLFW_GAMEPAD_AXIS_RIGHT_Y], 1000) != glfwRoundfd(glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_RIGHT_Y], 1000)) {
-				glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_RIGHT_X] = gpstate.axes[GLFW_GAMEPAD_AXIS_RIGHT_X];
-				glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_RIGHT_Y] = gpstate.axes[GLFW_GAMEPAD_AXIS_RIGHT_Y];
-				
-				if (glfwGamepadAxisCallback != NULL)
-					glfwGamepadAxisCallback(&gpstate, i, GLFW_GAMEPAD_AXIS_RIGHT_X, gpstate.axes[GLFW_GAMEPAD_AXIS_RIGHT_X], GLFW_GAMEPAD_AXIS_RIGHT_Y, gpstate.axes[GLFW_GAMEPAD_AXIS_RIGHT_Y]);
-			}
-
-			if (glfwRoundfd(gpstate.axes[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER], 1000) != glfwRoundfd(glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER], 1000)) {
-				glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER] = gpstate.axes[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER];
-				
-				if (glfwGamepadTriggerCallback != NULL)
-					glfwGamepadTriggerCallback(&gpstate, i, GLFW_GAMEPAD_AXIS_LEFT_TRIGGER, gpstate.axes[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER]);
-			}
-
-			if (glfwRoundfd(gpstate.axes[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER], 1000) != glfwRoundfd(glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER], 1000)) {
-				glfwGamepadCache[i].axes[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER] = gpstate.axes[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER];
-				
-				if (glfwGamepadTriggerCallback != NULL)
-					glfwGamepadTriggerCallback(&gpstate, i, GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER, gpstate.axes[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER]);
-			}
-		}
-	}
-
 	namespace TINYVULKAN_NAMESPACE {
 		/// <summary>GLFW window handler for TinyVulkan that will link to and initialize GLFW and Vulkan to create your game/application window</summary>
 		class TinyVkWindow : public TinyVkDisposable {
 		private:
 			bool hwndResizable;
-			int hwndWidth, hwndHeight, hwndXpos, hwndYpos;
+			struct TinyVkWindowRect { int width, height, xpos, ypos; };
+			/// <summary>Window size/position: written by GLFW callbacks, read every frame by render threads.</summary>
+			TinyVkSeqLock<TinyVkWindowRect> hwndRect { TinyVkWindowRect { 0, 0, 0, 0 } };
 			std::string title;
 			GLFWwindow* hwndWindow;
 
-			inline static TinyVkInvokable<GLFWwindow*, int, int> onWindowResized;
-			inline static TinyVkInvokable<GLFWwindow*, int, int> onWindowPositionMoved;
+			inline static TinyVkEventQueue<GLFWwindow*, int, int> onWindowResized;
+			inline static TinyVkEventQueue<GLFWwindow*, int, int> onWindowPositionMoved;
 
 			/// <summary>GLFWwindow unique pointer constructor.</summary>
 			virtual GLFWwindow* InitiateWindow(std::string title, int width, int height, bool resizable = true, bool transparentFramebuffer = false) {
@@ -85,20 +28,20 @@
 					throw new std::runtime_error("TinyVulkan: GLFW implementation could not locate Vulkan loader.");
 
 				hwndResizable = resizable;
-				hwndWidth = width;
-				hwndHeight = height;
-				return glfwCreateWindow(hwndWidth, hwndHeight, title.c_str(), nullptr, nullptr);
+				hwndRect.Update([width, height](TinyVkWindowRect& rect) { rect.width = width; rect.height = height; });
+				return glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
 			}
 
 			/// <summary>Generates an event for window framebuffer resizing.</summary>
 			inline static void OnFrameBufferNotifyReSizeCallback(GLFWwindow* hwnd, int width, int height) {
-				onResizeFrameBuffer.invoke(hwnd, width, height);
-				onWindowResized.invoke(hwnd, width, height);
+				// Window size first: resize handlers (swap chain re-creation) read the updated window rect.
+				onWindowResized.post(hwnd, width, height);
+				onResizeFrameBuffer.post(hwnd, width, height);
 			}
 
 			/// <summary>Generates an event for window position moved.</summary>
 			inline static void OnWindowPositionCallback(GLFWwindow* hwnd, int xpos, int ypos) {
-				onWindowPositionMoved.invoke(hwnd, xpos, ypos);
+				onWindowPositionMoved.post(hwnd, xpos, ypos);
 			}
 			
 		public:
@@ -117,8 +60,8 @@
 			/// <summary>Initiialize managed GLFW Window and Vulkan API. Initialize GLFW window unique_ptr.</summary>
 			TinyVkWindow(std::string title, int width, int height, bool resizable, bool transparentFramebuffer = false, bool hasMinSize = false, int minWidth = 200, int minHeight = 200) {
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose){this->Disposable(forceDispose); }));
-				onWindowResized.hook(TinyVkCallback<GLFWwindow*, int, int>([this](GLFWwindow* hwnd, int width, int height) { if (hwnd != hwndWindow) return; hwndWidth = width; hwndHeight = height; }));
-				onWindowPositionMoved.hook(TinyVkCallback<GLFWwindow*, int, int>([this](GLFWwindow* hwnd, int xpos, int ypos) { if (hwnd != hwndWindow) return; hwndXpos = xpos; hwndYpos = ypos; }));
+				onWindowResized.hook(TinyVkCallback<GLFWwindow*, int, int>([this](GLFWwindow* hwnd, int width, int height) { if (hwnd != hwndWindow) return; hwndRect.Update([width, height](TinyVkWindowRect& rect) { rect.width = width; rect.height = height; }); }));
+				onWindowPositionMoved.hook(TinyVkCallback<GLFWwindow*, int, int>([this](GLFWwindow* hwnd, int xpos, int ypos) { if (hwnd != hwndWindow) return; hwndRect.Update([xpos, ypos](TinyVkWindowRect& rect) { rect.xpos = xpos; rect.ypos = ypos; }); }));
 
 				hwndWindow = InitiateWindow(title, width, height, resizable, transparentFramebuffer);
 				glfwSetWindowUserPointer(hwndWindow, this);
@@ -134,7 +77,7 @@
 			TinyVkWindow(const TinyVkWindow&) = delete;
 
 			/// <summary>Invokable callback to respond to Vulkan API when the active frame buffer is resized.</suimmary>
-			inline static TinyVkInvokable<GLFWwindow*, int, int> onResizeFrameBuffer;
+			inline static TinyVkEventQueue<GLFWwindow*, int, int> onResizeFrameBuffer;
 
 			/// <summary>Pass to render engine for swapchain resizing.</summary>
 			void OnFrameBufferReSizeCallback(int& width, int& height) {
@@ -144,8 +87,7 @@
 				while (width <= 0 || height <= 0)
 					glfwGetFramebufferSize(hwndWindow, &width, &height);
 
-				hwndWidth = width;
-				hwndHeight = height;
+				hwndRect.Update([width, height](TinyVkWindowRect& rect) { rect.width = width; rect.height = height; });
 			}
 
 			/// <summary>[overridable] Checks if the GLFW window should close.</summary>
@@ -159,7 +101,7 @@
 				bool shouldClose = glfwWindowShouldClose(hwndWindow) == GLFW_TRUE;
 				glfwPollEvents();
 				#ifdef TINYVK_ALLOWS_POLLING_GAMEPADS
-				glfwPollGamepads();
+				gamepadPoller.Poll();
 				#endif
 				return shouldClose;
 			}
@@ -169,7 +111,7 @@
 				bool shouldClose = ShouldClose();
 				glfwWaitEvents();
 				#ifdef TINYVK_ALLOWS_POLLING_GAMEPADS
-				glfwPollGamepads();
+				gamepadPoller.Poll();
 				#endif
 				return shouldClose;
 			}
@@ -206,14 +148,14 @@
 			}
 
 			/// <summary>[overridable] Returns the window's framebuffer width.</summary>
-			virtual int GetWidth() { return std::max(hwndWidth, 1); }
+			virtual int GetWidth() { return std::max(hwndRect.Load().width, 1); }
 
 			/// <summary>[overridable] Returns the window's framebuffer height.</summary>
-			virtual int GetHeight() { return std::max(hwndHeight, 1); }
+			virtual int GetHeight() { return std::max(hwndRect.Load().height, 1); }
 
-			virtual int GetXpos() { return hwndXpos; }
+			virtual int GetXpos() { return hwndRect.Load().xpos; }
 
-			virtual int GetYpos() { return hwndYpos; }
+			virtual int GetYpos() { return hwndRect.Load().ypos; }
 
 			/// <summary>Executes functions in the main window loop (w/ ref to bool to exit loop as needed).</summary>
 			TinyVkInvokable<std::atomic<bool>&> onWhileMain;
@@ -230,97 +172,126 @@
 				}
 			}
 
+			/// <summary>Sets whether window/input events are invoked inside the GLFW callbacks (immediate) or queued until DispatchEvents() is called by the consuming thread.</summary>
+			static void SetEventDispatch(TinyVkEventDispatch mode) {
+				GetEventSequence();
+				onResizeFrameBuffer.set_dispatch(mode);
+				onWindowResized.set_dispatch(mode);
+				onWindowPositionMoved.set_dispatch(mode);
+				KeyboardButton.set_dispatch(mode);
+				MouseButton.set_dispatch(mode);
+				MouseMoved.set_dispatch(mode);
+				MouseScrolled.set_dispatch(mode);
+				MouseEntered.set_dispatch(mode);
+				GamepadConnection.set_dispatch(mode);
+				gamepadPoller.onGamepadChanged.set_dispatch(mode);
+			}
+
+			/// <summary>Invokes all queued window/input events on the calling thread in the order they were posted (call once per frame from the thread which owns the window's events), returns the number of events dispatched.</summary>
+			static size_t DispatchEvents() { return GetEventSequence().dispatch(); }
+
 			#pragma region GLFW GAMEPAD API
 
 		private:
-			inline static std::unordered_map<TinyVkKeyboardButtons, TinyVkInputEvents> cachedKeyboardStates;
-			inline static TinyVkInputEvents cachedMouseStates[static_cast<int32_t>(TinyVkMouseButtons::BUTTON_LAST) + 1];
-
-			struct TinyVkGamepadStruct { int32_t id; TinyVkInputEvents buttons[GLFW_JOYSTICK_LAST + 1]; };
-			inline static TinyVkGamepadStruct cachedGamepadStates[GLFW_JOYSTICK_LAST + 1];
-
-			inline static TinyVkInvokable<GLFWwindow*, TinyVkKeyboardButtons, TinyVkInputEvents, TinyVkModKeyBits> KeyboardButton;
-			inline static TinyVkInvokable<GLFWwindow*, TinyVkMouseButtons, TinyVkInputEvents, TinyVkModKeyBits> MouseButton;
-			inline static TinyVkInvokable<GLFWwindow*, double_t, double_t> MouseMoved;
-			inline static TinyVkInvokable<GLFWwindow*, double_t, double_t> MouseScrolled;
-			inline static TinyVkInvokable<GLFWwindow*, bool> MouseEntered;
-			inline static TinyVkInvokable<TinyVkGamepads, bool> GamepadConnection;
-			inline static TinyVkInvokable<TinyVkGamepads, TinyVkGamepadButtons, TinyVkInputEvents> GamepadButton;
-			inline static TinyVkInvokable<TinyVkGamepads, TinyVkGamepadAxis, float_t, TinyVkGamepadAxis, float_t> GamepadAxis;
-			inline static TinyVkInvokable<TinyVkGamepads, TinyVkGamepadAxis, float_t> GamepadTrigger;
+			TinyVkInputState inputState;
+
+			inline static TinyVkEventQueue<GLFWwindow*, TinyVkKeyboardButtons, TinyVkInputEvents, TinyVkModKeyBits> KeyboardButton;
+			inline static TinyVkEventQueue<GLFWwindow*, TinyVkMouseButtons, TinyVkInputEvents, TinyVkModKeyBits> MouseButton;
+			inline static TinyVkEventQueue<GLFWwindow*, double_t, double_t> MouseMoved;
+			inline static TinyVkEventQueue<GLFWwindow*, double_t, double_t> MouseScrolled;
+			inline static TinyVkEventQueue<GLFWwindow*, bool> MouseEntered;
+			inline static TinyVkEventQueue<TinyVkGamepads, bool> GamepadConnection;
+			inline static TinyVkGamepadPoller gamepadPoller;
+
+			/// <summary>Returns the sequence which keeps the posted order of all window/input event queues.</summary>
+			static TinyVkEventSequence& GetEventSequence() {
+				static TinyVkEventSequence sequence({ &onWindowResized, &onWindowPositionMoved, &onResizeFrameBuffer, &KeyboardButton, &MouseButton,
+					&MouseMoved, &MouseScrolled, &MouseEntered, &GamepadConnection, &gamepadPoller.onGamepadChanged });
+				return sequence;
+			}
 
 			inline static void KeyboardButtonCallback(GLFWwindow* window, int32_t button, int32_t action, int32_t scancode, int32_t mods) {
-				KeyboardButton.invoke(window, static_cast<TinyVkKeyboardButtons>(button), static_cast<TinyVkInputEvents>(action), static_cast<TinyVkModKeyBits>(mods));
+				KeyboardButton.post(window, static_cast<TinyVkKeyboardButtons>(button), static_cast<TinyVkInputEvents>(action), static_cast<TinyVkModKeyBits>(mods));
 			}
 			inline static void MouseButtonCallback(GLFWwindow* window, int32_t button, int32_t action, int32_t mods) {
-				MouseButton.invoke(window, static_cast<TinyVkMouseButtons>(button), static_cast<TinyVkInputEvents>(action), static_cast<TinyVkModKeyBits>(mods));
+				MouseButton.post(window, static_cast<TinyVkMouseButtons>(button), static_cast<TinyVkInputEvents>(action), static_cast<TinyVkModKeyBits>(mods));
 			}
 			inline static void MouseMovedCallback(GLFWwindow* window, double_t xpos, double_t ypos) {
-				MouseMoved.invoke(window, xpos, ypos);
+				MouseMoved.post(window, xpos, ypos);
 			}
 			inline static void MouseScrolledCallback(GLFWwindow* window, double_t xoffset, double_t yoffset) {
-				MouseScrolled.invoke(window, xoffset, yoffset);
+				MouseScrolled.post(window, xoffset, yoffset);
 			}
 			inline static void MouseEnteredCallback(GLFWwindow* window, int32_t entered) {
-				MouseEntered.invoke(window, entered);
+				MouseEntered.post(window, entered);
 			}
 			inline static void GamepadConnectionCallback(int32_t gpad, int32_t connected) {
-				GamepadConnection.invoke(static_cast<TinyVkGamepads>(gpad), connected == GLFW_CONNECTED);
-			}
-			inline static void GamepadButtonCallback(const GLFWgamepadstate* gpstate, int32_t gpad, int32_t button, int32_t action) {
-				GamepadButton.invoke(static_cast<TinyVkGamepads>(gpad), static_cast<TinyVkGamepadButtons>(button), static_cast<TinyVkInputEvents>(action));
-			}
-			inline static void GamepadAxisCallback(const GLFWgamepadstate* gpstate, int32_t gpad, int32_t axisXID, float_t axisX, int32_t axisYID, float_t axisY) {
-				GamepadAxis.invoke(static_cast<TinyVkGamepads>(gpad), static_cast<TinyVkGamepadAxis>(axisXID), axisX, static_cast<TinyVkGamepadAxis>(axisYID), axisY);
-			}
-			inline static void GamepadTriggerCallback(const GLFWgamepadstate* gpstate, int32_t gpad, int32_t axisID, float_t axis) {
-				GamepadTrigger.invoke(static_cast<TinyVkGamepads>(gpad), static_cast<TinyVkGamepadAxis>(axisID), axis);
+				gamepadPoller.SetConnected(static_cast<TinyVkGamepads>(gpad), connected == GLFW_CONNECTED);
+				GamepadConnection.post(static_cast<TinyVkGamepads>(gpad), connected == GLFW_CONNECTED);
 			}
 
 			void KeyboardButtonHandler(GLFWwindow* wnd, TinyVkKeyboardButtons button, TinyVkInputEvents action, TinyVkModKeyBits modKeys) {
 				if (wnd != hwndWindow) return;
 
-				TinyVkInputEvents cachedAction = action;
-				auto cached = cachedKeyboardStates.find(button);
-				if (cached != cachedKeyboardStates.end())
-					cachedAction = cached->second;
+				size_t bit = TinyVkInputBits::KeyBit(button);
+				TinyVkInputEvents cachedAction = (inputState.IsButtonDown(bit)) ? TinyVkInputEvents::PRESS : TinyVkInputEvents::RELEASE;
+				inputState.SetButton(bit, action != TinyVkInputEvents::RELEASE);
 
 				onKeyboardButtonChanged.invoke(button, modKeys, action, cachedAction);
 			}
 			void MouseButtonHandler(GLFWwindow* wnd, TinyVkMouseButtons button, TinyVkInputEvents action, TinyVkModKeyBits modKeys) {
 				if (wnd != hwndWindow) return;
 
-				TinyVkInputEvents cachedAction = cachedMouseStates[static_cast<int32_t>(button)];
+				size_t bit = TinyVkInputBits::MouseBit(button);
+				TinyVkInputEvents cachedAction = (inputState.IsButtonDown(bit)) ? TinyVkInputEvents::PRESS : TinyVkInputEvents::RELEASE;
+				inputState.SetButton(bit, action != TinyVkInputEvents::RELEASE);
+
 				onMouseButtonChanged.invoke(button, modKeys, action, cachedAction);
 			}
 			void MouseMovedHandler(GLFWwindow* wnd, double_t xpos, double_t ypos) {
 				if (wnd != hwndWindow) return;
 
+				inputState.SetMousePosition(xpos, ypos);
 				onMouseMoved.invoke(xpos, ypos);
 			}
 			void MouseScrolledHandler(GLFWwindow* wnd, double_t xoffset, double_t yoffset) {
 				if (wnd != hwndWindow) return;
 
+				inputState.AddMouseScroll(xoffset, yoffset);
 				onMouseScrolled.invoke(xoffset, yoffset);
 			}
 			void MouseEnteredHandler(GLFWwindow* wnd, bool entered) {
 				if (wnd != hwndWindow) return;
 
+				inputState.SetMouseInside(entered);
 				onMouseEntered.invoke(entered);
 			}
 			void GamepadConnectionHandler(TinyVkGamepads gpad, bool connected) {
 				onGamepadConnectionChanged.invoke(gpad, connected);
 			}
-			void GamepadButtonHandler(TinyVkGamepads gpad, TinyVkGamepadButtons button, TinyVkInputEvents action) {
-				TinyVkInputEvents cachedAction = cachedGamepadStates->buttons[static_cast<int32_t>(button)];
-				cachedGamepadStates->buttons[static_cast<int32_t>(button)] = static_cast<TinyVkInputEvents>(action);
-				onGamepadButtonChanged.invoke(gpad, button, action, cachedAction);
-			}
-			void GamepadAxisHandler(TinyVkGamepads gpad, TinyVkGamepadAxis axisXID, float_t axisX, TinyVkGamepadAxis axisYID, float_t axisY) {
-				onGamepadAxisChanged.invoke(gpad, axisXID, axisX, axisY);
-			}
-			void GamepadTriggerHandler(TinyVkGamepads gpad, TinyVkGamepadAxis axisID, float_t axis) {
-				onGamepadTriggerChanged.invoke(gpad, axisID, axis);
+			void GamepadChangedHandler(TinyVkGamepads gpad, const TinyVkGamepadChanges& changes) {
+				for (uint32_t buttons = changes.changedButtons; buttons != 0; buttons &= buttons - 1) {
+					TinyVkGamepadButtons button = static_cast<TinyVkGamepadButtons>(std::countr_zero(buttons));
+					TinyVkInputEvents action = (changes.IsButtonDown(button)) ? TinyVkInputEvents::PRESS : TinyVkInputEvents::RELEASE;
+					TinyVkInputEvents cachedAction = (action == TinyVkInputEvents::PRESS) ? TinyVkInputEvents::RELEASE : TinyVkInputEvents::PRESS;
+					inputState.SetButton(TinyVkInputBits::GamepadBit(gpad, button), action == TinyVkInputEvents::PRESS);
+					onGamepadButtonChanged.invoke(gpad, button, action, cachedAction);
+				}
+
+				for (int32_t axis = 0; axis <= GLFW_GAMEPAD_AXIS_LAST; axis++)
+					if (changes.AxisChanged(static_cast<TinyVkGamepadAxis>(axis)))
+						inputState.SetGamepadAxis(gpad, static_cast<TinyVkGamepadAxis>(axis), changes.axes[axis]);
+
+				if (changes.AxisChanged(TinyVkGamepadAxis::AXIS_LEFTX) || changes.AxisChanged(TinyVkGamepadAxis::AXIS_LEFTY))
+					onGamepadAxisChanged.invoke(gpad, TinyVkGamepadAxis::AXIS_LEFTX, changes.GetAxis(TinyVkGamepadAxis::AXIS_LEFTX), changes.GetAxis(TinyVkGamepadAxis::AXIS_LEFTY));
+				if (changes.AxisChanged(TinyVkGamepadAxis::AXIS_RIGHTX) || changes.AxisChanged(TinyVkGamepadAxis::AXIS_RIGHTY))
+					onGamepadAxisChanged.invoke(gpad, TinyVkGamepadAxis::AXIS_RIGHTX, changes.GetAxis(TinyVkGamepadAxis::AXIS_RIGHTX), changes.GetAxis(TinyVkGamepadAxis::AXIS_RIGHTY));
+				if (changes.AxisChanged(TinyVkGamepadAxis::AXIS_LEFTTR))
+					onGamepadTriggerChanged.invoke(gpad, TinyVkGamepadAxis::AXIS_LEFTTR, changes.GetAxis(TinyVkGamepadAxis::AXIS_LEFTTR));
+				if (changes.AxisChanged(TinyVkGamepadAxis::AXIS_RIGHTTR))
+					onGamepadTriggerChanged.invoke(gpad, TinyVkGamepadAxis::AXIS_RIGHTTR, changes.GetAxis(TinyVkGamepadAxis::AXIS_RIGHTTR));
+
+				onGamepadChanged.invoke(gpad, changes);
 			}
 
 			void InitGLFWInput() {
@@ -331,9 +302,7 @@
 				glfwSetScrollCallback(hwndWindow, MouseScrolledCallback);
 				glfwSetCursorEnterCallback(hwndWindow, MouseEnteredCallback);
 				glfwSetJoystickCallback(GamepadConnectionCallback);
-				glfwSetGamepadButtonCallback(GamepadButtonCallback);
-				glfwSetGamepadAxisCallback(GamepadAxisCallback);
-				glfwSetGamepadTriggerCallback(GamepadTriggerCallback);
+				gamepadPoller.Rescan();
 
 				KeyboardButton.hook(TinyVkCallback<GLFWwindow*, TinyVkKeyboardButtons, TinyVkInputEvents, TinyVkModKeyBits>([this](GLFWwindow* window, TinyVkKeyboardButtons button, TinyVkInputEvents action, TinyVkModKeyBits mods) { this->KeyboardButtonHandler(window, button, action, mods); }));
 				MouseButton.hook(TinyVkCallback<GLFWwindow*, TinyVkMouseButtons, TinyVkInputEvents, TinyVkModKeyBits>([this](GLFWwindow* window, TinyVkMouseButtons button, TinyVkInputEvents action, TinyVkModKeyBits mods) { this->MouseButtonHandler(window, button, action, mods); }));
@@ -341,9 +310,7 @@
 				MouseScrolled.hook(TinyVkCallback<GLFWwindow*, double_t, double_t>([this](GLFWwindow* window, double_t xoffset, double_t yoffset) { this->MouseScrolledHandler(window, xoffset, yoffset); }));
 				MouseEntered.hook(TinyVkCallback<GLFWwindow*, bool>([this](GLFWwindow* window, bool entered) { this->MouseEnteredHandler(window, entered); }));
 				GamepadConnection.hook(TinyVkCallback<TinyVkGamepads, bool>([this](TinyVkGamepads gpad, bool connected) { this->GamepadConnectionHandler(gpad, connected); }));
-				GamepadButton.hook(TinyVkCallback<TinyVkGamepads, TinyVkGamepadButtons, TinyVkInputEvents>([this](TinyVkGamepads gpad, TinyVkGamepadButtons button, TinyVkInputEvents action) { this->GamepadButtonHandler(gpad, button, action); }));
-				GamepadAxis.hook(TinyVkCallback<TinyVkGamepads, TinyVkGamepadAxis, float_t, TinyVkGamepadAxis, float_t>([this](TinyVkGamepads gpad, TinyVkGamepadAxis axisXID, float_t axisX, TinyVkGamepadAxis axisYID, float_t axisY) { this->GamepadAxisHandler(gpad, axisXID, axisX, axisYID, axisY); }));
-				GamepadTrigger.hook(TinyVkCallback<TinyVkGamepads, TinyVkGamepadAxis, float_t>([this](TinyVkGamepads gpad, TinyVkGamepadAxis axisID, float_t axis) { this->GamepadTriggerHandler(gpad, axisID, axis); }));
+				gamepadPoller.onGamepadChanged.hook(TinyVkCallback<TinyVkGamepads, TinyVkGamepadChanges>([this](TinyVkGamepads gpad, TinyVkGamepadChanges changes) { this->GamepadChangedHandler(gpad, changes); }));
 
 				for (int32_t i = 0; i < GLFW_JOYSTICK_LAST; i++) {
 					if (glfwJoystickPresent(i))
@@ -367,11 +334,22 @@
 			TinyVkInvokable<TinyVkGamepads, TinyVkGamepadAxis, float_t, float_t> onGamepadAxisChanged;
 			/// <summary>Gamepad Event Trigger Axis Changed: Gamepad ID, Axis ID, Y-Axis.</summary>
 			TinyVkInvokable<TinyVkGamepads, TinyVkGamepadAxis, float_t> onGamepadTriggerChanged;
+			/// <summary>Gamepad Event Changed (all button/axis changes of one gamepad per poll): Gamepad ID, Changes.</summary>
+			TinyVkInvokable<TinyVkGamepads, TinyVkGamepadChanges> onGamepadChanged;
 			/// <summary>Gamepad Event Initialized (Window Startup) Connected: True/False.</summary>
 			inline static TinyVkInvokable<TinyVkGamepads> onGamepadInitializeConnection;
 			/// <summary>Gamepad Event Connected: True/False.</summary>
 			TinyVkInvokable<TinyVkGamepads, bool> onGamepadConnectionChanged;
 
+			/// <summary>Publishes this window's input state as the next frame's TinyVkInputSnapshot (call once per frame from the application, after DispatchEvents()).</summary>
+			const TinyVkInputSnapshot& PublishInputSnapshot() { return inputState.PublishSnapshot(); }
+
+			/// <summary>Returns this window's last published TinyVkInputSnapshot (valid for one frame, copy it to keep it longer).</summary>
+			const TinyVkInputSnapshot& GetInputSnapshot() const { return inputState.GetSnapshot(); }
+
+			/// <summary>Returns the gamepad poller (polled by ShouldClosePollEvents()/ShouldCloseWaitEvents() with TINYVK_ALLOWS_POLLING_GAMEPADS) to set axis filters and the poll rate.</summary>
+			static TinyVkGamepadPoller& GetGamepadPoller() { return gamepadPoller; }
+
 			/// <summary>Gets the name of a GLFW gamepad.</summary>
 			std::string GamepadGlfwGetName(TinyVkGamepads gpad) {
 				const char* name = glfwGetJoystickName(static_cast<int32_t>(gpad));
@@ -28,6 +28,8 @@ void *rgba_pixels = qoi_read("image.qoi", &desc, 4);
 This library provides the following functions;
 - qoi_read    -- read and decode a QOI file
 - qoi_decode  -- decode the raw bytes of a QOI image from memory
+- qoi_decode_into -- decode the raw bytes of a QOI image into a caller buffer
+- qoi_read_header -- read the description of a QOI image from memory
 - qoi_write   -- encode and write a QOI file
 - qoi_encode  -- encode an rgba buffer into a QOI image in memory
 See the function declaration below for the signature and more information.
@@ -225,6 +227,26 @@ extern "C" {
 	void* qoi_decode(const void* data, int size, qoi_desc* desc, int channels);
 
 
+	/* Read the header of a QOI image from memory without decoding it.
+	The function returns 1 and fills the qoi_desc struct if the header is valid,
+	or 0 on failure (invalid data). */
+
+	int qoi_read_header(const void* data, int size, qoi_desc* desc);
+
+
+	/* Decode a QOI image from memory into the caller provided pixels buffer of
+	pixels_size bytes (e.g. mapped GPU staging memory), which must hold at least
+	width * height * channels bytes. If flags contains QOI_DECODE_BGR the red and
+	blue channels are swapped during decoding (BGR/BGRA output).
+	The function returns 1 on success or 0 on failure (invalid parameters or the
+	buffer is too small). The qoi_desc struct is filled with the description from
+	the file header if the header is valid. */
+
+	#define QOI_DECODE_BGR 1
+
+	int qoi_decode_into(const void* data, int size, qoi_desc* desc, void* pixels, int pixels_size, int channels, int flags);
+
+
 #ifdef __cplusplus
 
 }
@@ -257,6 +279,12 @@ Implementation */
 #define QOI_MASK_2    0xc0 /* 11000000 */
 
 #define QOI_COLOR_HASH(C) (C.rgba.r*3 + C.rgba.g*5 + C.rgba.b*7 + C.rgba.a*11)
+/* SWAR color hash: spreads r,g,b,a into 16-bit lanes so that one 64-bit multiply
+sums r*3 + g*5 + b*7 + a*11 into the top lane (no lane can overflow). */
+#define QOI_COLOR_HASH_SWAR(C) ((unsigned int)((( \
+	((unsigned long long)C.rgba.r) | ((unsigned long long)C.rgba.g << 16) | \
+	((unsigned long long)C.rgba.b << 32) | ((unsigned long long)C.rgba.a << 48)) * \
+	((3ULL << 48) | (5ULL << 32) | (7ULL << 16) | 11ULL)) >> 48) & 63)
 #define QOI_MAGIC \
 	(((unsigned int)'q') << 24 | ((unsigned int)'o') << 16 | \
 	 ((unsigned int)'i') <<  8 | ((unsigned int)'f'))
@@ -417,21 +445,128 @@ void* qoi_encode(const void* data, const qoi_desc* desc, int* out_len) {
 	return bytes;
 }
 
-void* qoi_decode(const void* data, int size, qoi_desc* desc, int channels) {
+/* Fills count 4-channel pixels of dst with px (runs). */
+static void qoi_fill_run_4(unsigned char* dst, qoi_rgba_t px, int count) {
+	for (; count > 0; count--, dst += 4) {
+		memcpy(dst, &px.v, 4);
+	}
+}
+
+/* Fills count 3-channel pixels of dst with px (runs). */
+static void qoi_fill_run_3(unsigned char* dst, qoi_rgba_t px, int count) {
+	for (; count > 0; count--, dst += 3) {
+		dst[0] = px.rgba.r;
+		dst[1] = px.rgba.g;
+		dst[2] = px.rgba.b;
+	}
+}
+
+/* Returns px with red and blue swapped if bgr is set. */
+static qoi_rgba_t qoi_swizzle(qoi_rgba_t px, int bgr) {
+	if (bgr) {
+		unsigned char r = px.rgba.r;
+		px.rgba.r = px.rgba.b;
+		px.rgba.b = r;
+	}
+	return px;
+}
+
+/* Decodes the chunks of a QOI image (starting after the header at p) into
+pixels. Runs are filled outside of the chunk loop, 4-channel pixels are written
+with a single 32-bit store and the index writeback uses the SWAR hash. The result is bit-exact
+with the scalar reference decoder, including truncated/malformed data (once the
+chunks run out the last pixel is repeated). If bgr is set red and blue are
+swapped on output (the index always holds the unswizzled pixels). */
+static void qoi_decode_chunks(const unsigned char* bytes, int size, int p, unsigned char* pixels, int px_count, int channels, int bgr) {
+	qoi_rgba_t index[64];
+	qoi_rgba_t px, out;
+	int px_pos = 0, run, chunks_len;
+
+	QOI_ZEROARR(index);
+	px.rgba.r = 0;
+	px.rgba.g = 0;
+	px.rgba.b = 0;
+	px.rgba.a = 255;
+
+	chunks_len = size - (int)sizeof(qoi_padding);
+	while (px_pos < px_count) {
+		int b1;
+
+		if (p >= chunks_len) {
+			out = qoi_swizzle(px, bgr);
+			run = px_count - px_pos;
+			if (channels == 4) {
+				qoi_fill_run_4(pixels + px_pos * 4, out, run);
+			} else {
+				qoi_fill_run_3(pixels + px_pos * 3, out, run);
+			}
+			return;
+		}
+
+		b1 = bytes[p++];
+
+		if (b1 < QOI_OP_DIFF) {
+			px = index[b1];
+		} else if (b1 < QOI_OP_LUMA) {
+			px.rgba.r += ((b1 >> 4) & 0x03) - 2;
+			px.rgba.g += ((b1 >> 2) & 0x03) - 2;
+			px.rgba.b += (b1 & 0x03) - 2;
+		} else if (b1 < QOI_OP_RUN) {
+			int b2 = bytes[p++];
+			int vg = (b1 & 0x3f) - 32;
+			px.rgba.r += vg - 8 + ((b2 >> 4) & 0x0f);
+			px.rgba.g += vg;
+			px.rgba.b += vg - 8 + (b2 & 0x0f);
+		} else if (b1 < QOI_OP_RGB) {
+			index[QOI_COLOR_HASH_SWAR(px)] = px;
+
+			run = (b1 & 0x3f) + 1;
+			if (run > px_count - px_pos) {
+				run = px_count - px_pos;
+			}
+
+			out = qoi_swizzle(px, bgr);
+			if (channels == 4) {
+				qoi_fill_run_4(pixels + px_pos * 4, out, run);
+			} else {
+				qoi_fill_run_3(pixels + px_pos * 3, out, run);
+			}
+
+			px_pos += run;
+			continue;
+		} else if (b1 == QOI_OP_RGB) {
+			px.rgba.r = bytes[p++];
+			px.rgba.g = bytes[p++];
+			px.rgba.b = bytes[p++];
+		} else {
+			px.rgba.r = bytes[p++];
+			px.rgba.g = bytes[p++];
+			px.rgba.b = bytes[p++];
+			px.rgba.a = bytes[p++];
+		}
+
+		index[QOI_COLOR_HASH_SWAR(px)] = px;
+
+		out = qoi_swizzle(px, bgr);
+		if (channels == 4) {
+			memcpy(pixels + px_pos * 4, &out.v, 4);
+		} else {
+			pixels[px_pos * 3 + 0] = out.rgba.r;
+			pixels[px_pos * 3 + 1] = out.rgba.g;
+			pixels[px_pos * 3 + 2] = out.rgba.b;
+		}
+
+		px_pos++;
+	}
+}
+
+int qoi_read_header(const void* data, int size, qoi_desc* desc) {
 	const unsigned char* bytes;
 	unsigned int header_magic;
-	unsigned char* pixels;
-	qoi_rgba_t index[64];
-	qoi_rgba_t px;
-	int px_len, chunks_len, px_pos;
-	int p = 0, run = 0;
+	int p = 0;
 
-	if (
-		data == NULL || desc == NULL ||
-		(channels != 0 && channels != 3 && channels != 4) ||
-		size < QOI_HEADER_SIZE + (int)sizeof(qoi_padding)
-		) {
-		return NULL;
+	if (data == NULL || desc == NULL || size < QOI_HEADER_SIZE + (int)sizeof(qoi_padding)) {
+		return 0;
 	}
 
 	bytes = (const unsigned char*)data;
@@ -449,69 +584,52 @@ void* qoi_decode(const void* data, int size, qoi_desc* desc, int channels) {
 		header_magic != QOI_MAGIC ||
 		desc->height >= QOI_PIXELS_MAX / desc->width
 		) {
-		return NULL;
+		return 0;
+	}
+
+	return 1;
+}
+
+int qoi_decode_into(const void* data, int size, qoi_desc* desc, void* pixels, int pixels_size, int channels, int flags) {
+	if (
+		pixels == NULL ||
+		(channels != 0 && channels != 3 && channels != 4) ||
+		!qoi_read_header(data, size, desc)
+		) {
+		return 0;
 	}
 
 	if (channels == 0) {
 		channels = desc->channels;
 	}
 
-	px_len = desc->width * desc->height * channels;
-	pixels = (unsigned char*)QOI_MALLOC(px_len);
-	if (!pixels) {
-		return NULL;
+	if (pixels_size < 0 || (unsigned int)pixels_size / channels / desc->width < desc->height) {
+		return 0;
 	}
 
-	QOI_ZEROARR(index);
-	px.rgba.r = 0;
-	px.rgba.g = 0;
-	px.rgba.b = 0;
-	px.rgba.a = 255;
+	qoi_decode_chunks((const unsigned char*)data, size, QOI_HEADER_SIZE, (unsigned char*)pixels, desc->width * desc->height, channels, flags & QOI_DECODE_BGR);
+	return 1;
+}
 
-	chunks_len = size - (int)sizeof(qoi_padding);
-	for (px_pos = 0; px_pos < px_len; px_pos += channels) {
-		if (run > 0) {
-			run--;
-		} else if (p < chunks_len) {
-			int b1 = bytes[p++];
-
-			if (b1 == QOI_OP_RGB) {
-				px.rgba.r = bytes[p++];
-				px.rgba.g = bytes[p++];
-				px.rgba.b = bytes[p++];
-			} else if (b1 == QOI_OP_RGBA) {
-				px.rgba.r = bytes[p++];
-				px.rgba.g = bytes[p++];
-				px.rgba.b = bytes[p++];
-				px.rgba.a = bytes[p++];
-			} else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
-				px = index[b1];
-			} else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
-				px.rgba.r += ((b1 >> 4) & 0x03) - 2;
-				px.rgba.g += ((b1 >> 2) & 0x03) - 2;
-				px.rgba.b += (b1 & 0x03) - 2;
-			} else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
-				int b2 = bytes[p++];
-				int vg = (b1 & 0x3f) - 32;
-				px.rgba.r += vg - 8 + ((b2 >> 4) & 0x0f);
-				px.rgba.g += vg;
-				px.rgba.b += vg - 8 + (b2 & 0x0f);
-			} else if ((b1 & QOI_MASK_2) == QOI_OP_RUN) {
-				run = (b1 & 0x3f);
-			}
+void* qoi_decode(const void* data, int size, qoi_desc* desc, int channels) {
+	unsigned char* pixels;
+	int px_len;
 
-			index[QOI_COLOR_HASH(px) % 64] = px;
-		}
+	if ((channels != 0 && channels != 3 && channels != 4) || !qoi_read_header(data, size, desc)) {
+		return NULL;
+	}
 
-		pixels[px_pos + 0] = px.rgba.r;
-		pixels[px_pos + 1] = px.rgba.g;
-		pixels[px_pos + 2] = px.rgba.b;
+	if (channels == 0) {
+		channels = desc->channels;
+	}
 
-		if (channels == 4) {
-			pixels[px_pos + 3] = px.rgba.a;
-		}
+	px_len = desc->width * desc->height * channels;
+	pixels = (unsigned char*)QOI_MALLOC(px_len);
+	if (!pixels) {
+		return NULL;
 	}
 
+	qoi_decode_chunks((const unsigned char*)data, size, QOI_HEADER_SIZE, pixels, desc->width * desc->height, channels, 0);
 	return pixels;
 }
 